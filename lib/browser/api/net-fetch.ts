@@ -15,7 +15,7 @@ function createDeferredPromise<T, E extends Error = Error> (): { promise: Promis
   return { promise, resolve: res!, reject: rej! };
 }
 
-export function fetchWithSession (input: RequestInfo, init: (RequestInit & {bypassCustomProtocolHandlers?: boolean}) | undefined, session: SessionT | undefined,
+export function fetchWithSession (input: RequestInfo, init: (RequestInit & {bypassCustomProtocolHandlers?: boolean, chunkSize?: number}) | undefined, session: SessionT | undefined,
   request: (options: ClientRequestConstructorOptions | string) => ClientRequest) {
   const p = createDeferredPromise<Response>();
   let req: Request;
@@ -84,7 +84,8 @@ export function fetchWithSession (input: RequestInfo, init: (RequestInit & {bypa
     credentials,
     cache: req.cache,
     referrerPolicy: req.referrerPolicy,
-    redirect: req.redirect
+    redirect: req.redirect,
+    chunkSize: init?.chunkSize
   }));
 
   (r as any)._urlLoaderOptions.bypassCustomProtocolHandlers = !!init?.bypassCustomProtocolHandlers;
@@ -108,6 +108,28 @@ function validateResponse (res: Response) {
   return true;
 }
 
+// The response cache only stores buffered bodies, but bodies that can't fit
+// in it are streamed instead of being held in memory.
+async function bufferBody (body: ReadableStream<Uint8Array>, maxSize: number): Promise<Buffer | Readable> {
+  const reader = body.getReader();
+  const chunks: Uint8Array[] = [];
+  let size = 0;
+  while (size <= maxSize) {
+    const { done, value } = await reader.read();
+    if (done) return Buffer.concat(chunks);
+    chunks.push(value);
+    size += value.byteLength;
+  }
+  return Readable.from((async function * () {
+    yield * chunks.splice(0);
+    while (true) {
+      const { done, value } = await reader.read();
+      if (done) return;
+      yield value;
+    }
+  })());
+}
+
 Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, handler: (req: Request) => Response | Promise<Response>) {
   const register = isBuiltInScheme(scheme) ? this.interceptProtocol : this.registerProtocol;
   const success = register.call(this, scheme, async (preq: ProtocolRequest, cb: any) => {
@@ -130,8 +152,15 @@ Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, h
       } else if (res.type === 'error') {
         cb({ error: ERR_FAILED });
       } else {
+        let data: Buffer | Readable | null = null;
+        const cacheMaxSize = preq.method === 'GET' ? this._getResponseCacheMaxSize(scheme) : null;
+        if (res.body && cacheMaxSize !== null) {
+          data = await bufferBody(res.body as ReadableStream<Uint8Array>, cacheMaxSize);
+        } else if (res.body) {
+          data = Readable.fromWeb(res.body as ReadableStream<ArrayBufferView>);
+        }
         cb({
-          data: res.body ? Readable.fromWeb(res.body as ReadableStream<ArrayBufferView>) : null,
+          data,
           headers: res.headers ? Object.fromEntries(res.headers) : {},
           statusCode: res.status,
           statusText: res.statusText,
@@ -177,7 +206,12 @@ const protocol = {
   isProtocolIntercepted: (...args) => session.defaultSession.protocol.isProtocolIntercepted(...args),
   handle: (...args) => session.defaultSession.protocol.handle(...args),
   unhandle: (...args) => session.defaultSession.protocol.unhandle(...args),
-  isProtocolHandled: (...args) => session.defaultSession.protocol.isProtocolHandled(...args)
+  isProtocolHandled: (...args) => session.defaultSession.protocol.isProtocolHandled(...args),
+  mount: (...args) => session.defaultSession.protocol.mount(...args),
+  unmount: (...args) => session.defaultSession.protocol.unmount(...args),
+  enableResponseCache: (...args) => session.defaultSession.protocol.enableResponseCache(...args),
+  disableResponseCache: (...args) => session.defaultSession.protocol.disableResponseCache(...args),
+  getResponseCacheStats: (...args) => session.defaultSession.protocol.getResponseCacheStats(...args)
 } as typeof Electron.protocol;
 
 export default protocol;
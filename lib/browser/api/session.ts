@@ -2,7 +2,7 @@ import { fetchWithSession } from '@electron/internal/browser/api/net-fetch';
 import { addIpcDispatchListeners } from '@electron/internal/browser/ipc-dispatch';
 import * as deprecate from '@electron/internal/common/deprecate';
 
-import { net } from 'electron/main';
+import { net, webContents, webFrameMain } from 'electron/main';
 
 const { fromPartition, fromPath, Session } = process._linkedBinding('electron_browser_session');
 const { isDisplayMediaSystemPickerAvailable } = process._linkedBinding('electron_browser_desktop_capturer');
@@ -45,6 +45,13 @@ Session.prototype.fetch = function (input: RequestInfo, init?: RequestInit) {
   return fetchWithSession(input, init, this, net.request);
 };
 
+Session.prototype.sendToAllWebContents = function (channel: string, ...args: any[]) {
+  const frames = webContents.getAllWebContents()
+    .filter(contents => contents.session === this && !contents.isDestroyed())
+    .map(contents => contents.mainFrame);
+  return webFrameMain.broadcast(frames, channel, ...args);
+};
+
 Session.prototype.setDisplayMediaRequestHandler = function (handler, opts) {
   if (!handler) return this._setDisplayMediaRequestHandler(handler, opts);
 
@@ -140,6 +140,10 @@ function getWebFrame (contents: Electron.WebContents, frame: number | [number, n
   }
 }
 
+WebContents.prototype.sendToAllFrames = function (channel, ...args) {
+  return webFrameMain.broadcast(this.mainFrame.framesInSubtree, channel, ...args);
+};
+
 WebContents.prototype.sendToFrame = function (frameId, channel, ...args) {
   const frame = getWebFrame(this, frameId);
   if (!frame) return false;
@@ -241,6 +245,7 @@ WebContents.prototype.printToPDF = async function (options) {
     preferCSSPageSize: checkType(options.preferCSSPageSize ?? false, 'boolean', 'preferCSSPageSize'),
     generateTaggedPDF: checkType(options.generateTaggedPDF ?? false, 'boolean', 'generateTaggedPDF'),
     generateDocumentOutline: checkType(options.generateDocumentOutline ?? false, 'boolean', 'generateDocumentOutline'),
+    filePath: checkType(options.filePath ?? '', 'string', 'filePath'),
     ...pageSize
   };
 
@@ -882,6 +887,221 @@ export function create (options = {}): Electron.WebContents {
   return new (WebContents as any)(options);
 }
 
+// Offscreen WebContents that printed a batch are kept per session for the
+// next printToPDFBatch() call, until they have been idle for a while.
+const kMaxIdlePrintContents = 4;
+const kPrintContentsIdleTimeout = 30 * 1000;
+const printPools = new Map<Electron.Session | undefined, { idle: Electron.WebContents[], timer?: NodeJS.Timeout }>();
+
+function acquirePrintContents (ses: Electron.Session | undefined) {
+  const pool = printPools.get(ses);
+  while (pool && pool.idle.length > 0) {
+    const contents = pool.idle.pop()!;
+    if (!contents.isDestroyed() && !contents.isCrashed()) return contents;
+    if (!contents.isDestroyed()) contents.destroy();
+  }
+  return create({ session: ses, sandbox: true, offscreen: true });
+}
+
+function releasePrintContents (ses: Electron.Session | undefined, contents: Electron.WebContents) {
+  if (contents.isDestroyed()) return;
+  let pool = printPools.get(ses);
+  if (!pool) {
+    pool = { idle: [] };
+    printPools.set(ses, pool);
+  }
+  if (contents.isCrashed() || pool.idle.length >= kMaxIdlePrintContents) {
+    contents.destroy();
+    return;
+  }
+  pool.idle.push(contents);
+  clearTimeout(pool.timer);
+  const idlePool = pool;
+  pool.timer = setTimeout(() => {
+    if (printPools.get(ses) === idlePool) printPools.delete(ses);
+    for (const idle of idlePool.idle) {
+      if (!idle.isDestroyed()) idle.destroy();
+    }
+  }, kPrintContentsIdleTimeout);
+  pool.timer.unref();
+}
+
+function withTimeout<T> (promise: Promise<T>, timeout: number): Promise<T> {
+  let timer: NodeJS.Timeout;
+  const timedOut = new Promise<never>((resolve, reject) => {
+    timer = setTimeout(() => {
+      const error = new Error(`Timed out after ${timeout}ms`);
+      error.name = 'TimeoutError';
+      reject(error);
+    }, timeout);
+  });
+  return Promise.race([promise, timedOut]).finally(() => clearTimeout(timer));
+}
+
+// Prints many documents to PDF, reusing a small pool of offscreen WebContents
+// instead of spawning a renderer for every document.
+export async function printToPDFBatch (jobs: Electron.PrintToPDFJob[], options: Electron.PrintToPDFBatchOptions = {}): Promise<Electron.PrintToPDFJobResult[]> {
+  if (!Array.isArray(jobs)) {
+    throw new TypeError('jobs must be an array');
+  }
+  const concurrency = checkType(options.concurrency ?? 2, 'number', 'concurrency');
+  if (!Number.isInteger(concurrency) || concurrency < 1) {
+    throw new RangeError('concurrency must be a positive integer');
+  }
+  const timeout = checkType(options.timeout ?? 30000, 'number', 'timeout');
+  if (!(timeout > 0)) {
+    throw new RangeError('timeout must be a positive number');
+  }
+
+  const results: Electron.PrintToPDFJobResult[] = new Array(jobs.length);
+  let nextJob = 0;
+
+  const runJob = async (contents: Electron.WebContents, job: Electron.PrintToPDFJob, start: number) => {
+    if (typeof job.html === 'string') {
+      // The markup is written into an empty data: document, so that it gets
+      // an opaque origin without the 2MB limit of data: URLs. Loading it from
+      // a file would let it read other local files.
+      await contents.loadURL('data:text/html,');
+      await contents.executeJavaScript(`new Promise(resolve => {
+        document.open();
+        document.write(${JSON.stringify(job.html)});
+        document.close();
+        if (document.readyState === 'complete') resolve();
+        else window.addEventListener('load', () => resolve(), { once: true });
+      })`);
+    } else if (typeof job.url === 'string') {
+      await contents.loadURL(job.url);
+    } else {
+      throw new TypeError('Each job must have either a url or an html string');
+    }
+    const loadTime = performance.now() - start;
+    const data = await contents.printToPDF(job.options ?? {});
+    return { data, loadTime, printTime: performance.now() - start - loadTime };
+  };
+
+  const runWorker = async () => {
+    let contents: Electron.WebContents | null = null;
+    try {
+      while (nextJob < jobs.length) {
+        const index = nextJob++;
+        const start = performance.now();
+        try {
+          contents ??= acquirePrintContents(options.session);
+          results[index] = await withTimeout(runJob(contents, jobs[index], start), timeout);
+        } catch (error: any) {
+          results[index] = { error: String(error?.message ?? error), loadTime: performance.now() - start, printTime: 0 };
+          // Don't let a crashed or wedged renderer fail the following jobs.
+          if (contents && (contents.isDestroyed() || contents.isCrashed() || error?.name === 'TimeoutError')) {
+            if (!contents.isDestroyed()) contents.destroy();
+            contents = null;
+          }
+        }
+      }
+    } finally {
+      if (contents) releasePrintContents(options.session, contents);
+    }
+  };
+
+  const workers = [];
+  for (let i = 0; i < Math.min(concurrency, jobs.length); i++) {
+    workers.push(runWorker());
+  }
+  await Promise.all(workers);
+  return results;
+}
+
+// Spare WebContents whose renderer has already been launched, so that a new
+// window doesn't have to wait for process startup. Spares are keyed by their
+// webPreferences, since those decide how the renderer is set up.
+const sparePools = new Map<string, { webPreferences: Electron.WebPreferences, size: number, spares: Electron.WebContents[] }>();
+const spareStats = { hits: 0, misses: 0 };
+const spareDiscarders = new WeakMap<Electron.WebContents, () => void>();
+const sessionIds = new WeakMap<Electron.Session, number>();
+let nextSessionId = 0;
+
+function getSpareKey (webPreferences: Electron.WebPreferences) {
+  const { session: ses, ...rest } = webPreferences;
+  let sessionKey = '';
+  if (ses) {
+    if (!sessionIds.has(ses)) sessionIds.set(ses, nextSessionId++);
+    sessionKey = `session:${sessionIds.get(ses)}`;
+  }
+  // Sort keys so that equal preferences always produce the same key.
+  return sessionKey + JSON.stringify(rest, (key, value) => {
+    if (value === null || typeof value !== 'object' || Array.isArray(value)) return value;
+    return Object.fromEntries(Object.entries(value).sort(([a], [b]) => a < b ? -1 : a > b ? 1 : 0));
+  });
+}
+
+function releaseSpare (contents: Electron.WebContents) {
+  const discard = spareDiscarders.get(contents);
+  if (!discard) return;
+  contents.removeListener('render-process-gone', discard);
+  contents.removeListener('destroyed', discard);
+  spareDiscarders.delete(contents);
+}
+
+function fillSparePool (key: string) {
+  const pool = sparePools.get(key);
+  if (!pool) return;
+  while (pool.spares.length < pool.size) {
+    const contents = create({ ...pool.webPreferences });
+    const discard = () => {
+      const index = pool.spares.indexOf(contents);
+      if (index === -1) return;
+      pool.spares.splice(index, 1);
+      if (!contents.isDestroyed()) contents.destroy();
+    };
+    contents.once('render-process-gone', discard);
+    contents.once('destroyed', discard);
+    spareDiscarders.set(contents, discard);
+    pool.spares.push(contents);
+    contents.loadURL('about:blank').catch(discard);
+  }
+}
+
+export function prewarm (webPreferences: Electron.WebPreferences = {}, count = 1) {
+  if (!Number.isInteger(count) || count < 0) {
+    throw new RangeError('count must be a non-negative integer');
+  }
+  const key = getSpareKey(webPreferences);
+  let pool = sparePools.get(key);
+  if (!pool) {
+    pool = { webPreferences: { ...webPreferences }, size: count, spares: [] };
+    sparePools.set(key, pool);
+  }
+  pool.size = count;
+  for (const contents of pool.spares.splice(count)) {
+    releaseSpare(contents);
+    contents.destroy();
+  }
+  if (count === 0) {
+    sparePools.delete(key);
+    return;
+  }
+  fillSparePool(key);
+}
+
+export function takeSpare (webPreferences: Electron.WebPreferences = {}): Electron.WebContents {
+  const key = getSpareKey(webPreferences);
+  const pool = sparePools.get(key);
+  const contents = pool?.spares.shift();
+  if (!contents) {
+    spareStats.misses++;
+    return create({ ...webPreferences });
+  }
+  spareStats.hits++;
+  releaseSpare(contents);
+  // Replace the spare we just handed out once the caller is done with the
+  // current task, so that it doesn't compete with the new window's startup.
+  setImmediate(() => fillSparePool(key));
+  return contents;
+}
+
+export function getSpareStats () {
+  return { ...spareStats };
+}
+
 export function fromId (id: string) {
   return binding.fromId(id);
 }
@@ -1,7 +1,7 @@
 import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 
-const { WebFrameMain, fromId } = process._linkedBinding('electron_browser_web_frame_main');
+const { WebFrameMain, fromId, _broadcast } = process._linkedBinding('electron_browser_web_frame_main');
 
 Object.defineProperty(WebFrameMain.prototype, 'ipc', {
   get () {
@@ -42,6 +42,18 @@ WebFrameMain.prototype.postMessage = function (...args) {
   this._postMessage(...args);
 };
 
+const broadcast = (frames: Electron.WebFrameMain[], channel: string, ...args: any[]) => {
+  if (!Array.isArray(frames)) {
+    throw new TypeError('Missing required frames argument');
+  }
+  if (typeof channel !== 'string') {
+    throw new TypeError('Missing required channel argument');
+  }
+
+  return _broadcast(false /* internal */, channel, args, frames);
+};
+
 export default {
-  fromId
+  fromId,
+  broadcast
 };
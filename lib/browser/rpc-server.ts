@@ -3,6 +3,7 @@ import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-util
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 
 import { clipboard } from 'electron/common';
+import { app } from 'electron/main';
 
 import * as fs from 'fs';
 import * as path from 'path';
@@ -85,9 +86,22 @@ const readPreloadScript = async function (script: Electron.PreloadScript): Promi
   };
 };
 
+// Only the first preload run is part of the startup timeline, so renderers
+// stop reporting when their preloads ran once it has been recorded.
+let preloadEndRecorded = false;
+
+// Returns whether the renderer should report when its preloads ran.
+const markPreloadStart = function () {
+  if (preloadEndRecorded) return false;
+  app._markStartup('preloadStart');
+  return true;
+};
+
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event) {
+  const reportPreloadLoaded = markPreloadStart();
   const preloadScripts = getPreloadScriptsFromEvent(event);
   return {
+    reportPreloadLoaded,
     preloadScripts: await Promise.all(preloadScripts.map(readPreloadScript)),
     process: {
       arch: process.arch,
@@ -101,8 +115,15 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event
 });
 
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD, function (event) {
+  const reportPreloadLoaded = markPreloadStart();
   const preloadScripts = getPreloadScriptsFromEvent(event);
-  return { preloadPaths: preloadScripts.map(script => script.filePath) };
+  return { reportPreloadLoaded, preloadPaths: preloadScripts.map(script => script.filePath) };
+});
+
+ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_LOADED, function () {
+  if (preloadEndRecorded) return;
+  preloadEndRecorded = true;
+  app._markStartup('preloadEnd');
 });
 
 ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_ERROR, function (event, preloadPath: string, error: Error) {
@@ -14,6 +14,9 @@ const {
 
 const kHttpProtocols = new Set(['http:', 'https:']);
 
+// Largest chunkSize accepted, see electron_api_url_loader.cc.
+const kMaxChunkSize = 16 * 1024 * 1024;
+
 // set of headers that Node.js discards duplicates for
 // see https://nodejs.org/api/http.html#http_message_headers
 const discardableDuplicateHeaders = new Set([
@@ -277,6 +280,10 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     throw new TypeError('headers must be an object');
   }
 
+  if (options.chunkSize != null && (!Number.isInteger(options.chunkSize) || options.chunkSize < 0 || options.chunkSize > kMaxChunkSize)) {
+    throw new TypeError(`chunkSize must be a non-negative integer not greater than ${kMaxChunkSize}`);
+  }
+
   const urlLoaderOptions: NodeJS.CreateURLLoaderOptions & { redirectPolicy: RedirectPolicy, headers: Record<string, { name: string, value: string | string[] }>, allowNonHttpProtocols: boolean } = {
     method: (options.method || 'GET').toUpperCase(),
     url: urlStr,
@@ -288,6 +295,7 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     origin: options.origin,
     referrerPolicy: options.referrerPolicy,
     cache: options.cache,
+    chunkSize: options.chunkSize,
     allowNonHttpProtocols: Object.hasOwn(options, kAllowNonHttpProtocols)
   };
   const headers: Record<string, string | string[]> = options.headers || {};
@@ -440,8 +448,8 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
       const response = this._response = new IncomingMessage(responseHead);
       this.emit('response', response);
     });
-    this._urlLoader.on('data', (event, data, resume) => {
-      this._response!._storeInternalData(Buffer.from(data), resume);
+    this._urlLoader.on('data', (event, data, resume, length) => {
+      this._response!._storeInternalData(Buffer.from(data, 0, length), resume);
     });
     this._urlLoader.on('complete', () => {
       if (this._response) { this._response._storeInternalData(null, null); }
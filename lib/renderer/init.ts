@@ -133,7 +133,10 @@ if (nodeIntegration) {
 const { appCodeLoaded } = process;
 delete process.appCodeLoaded;
 
-const { preloadPaths } = ipcRendererUtils.invokeSync<{ preloadPaths: string[] }>(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD);
+const { preloadPaths, reportPreloadLoaded } = ipcRendererUtils.invokeSync<{
+  preloadPaths: string[];
+  reportPreloadLoaded: boolean;
+}>(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD);
 const cjsPreloads = preloadPaths.filter(p => path.extname(p) !== '.mjs');
 const esmPreloads = preloadPaths.filter(p => path.extname(p) === '.mjs');
 if (cjsPreloads.length) {
@@ -162,7 +165,11 @@ if (esmPreloads.length) {
         ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_ERROR, preloadScript, err);
       });
     }
-  }).finally(() => appCodeLoaded!());
+  }).finally(() => {
+    if (reportPreloadLoaded) ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_LOADED);
+    appCodeLoaded!();
+  });
 } else {
+  if (reportPreloadLoaded) ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_LOADED);
   appCodeLoaded!();
 }
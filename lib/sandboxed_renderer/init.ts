@@ -1,5 +1,6 @@
 import '@electron/internal/sandboxed_renderer/pre-init';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
+import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 import type * as ipcRendererUtilsModule from '@electron/internal/renderer/ipc-renderer-internal-utils';
 import { createPreloadProcessObject, executeSandboxedPreloadScripts } from '@electron/internal/sandboxed_renderer/preload';
 
@@ -15,10 +16,12 @@ const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-inter
 
 const {
   preloadScripts,
-  process: processProps
+  process: processProps,
+  reportPreloadLoaded
 } = ipcRendererUtils.invokeSync<{
   preloadScripts: ElectronInternal.PreloadScript[];
   process: NodeJS.Process;
+  reportPreloadLoaded: boolean;
 }>(IPC_MESSAGES.BROWSER_SANDBOX_LOAD);
 
 const electron = require('electron');
@@ -69,3 +72,7 @@ executeSandboxedPreloadScripts({
     clearImmediate
   }
 }, preloadScripts);
+
+if (reportPreloadLoaded) {
+  ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_LOADED);
+}
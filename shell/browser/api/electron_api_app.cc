@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <string>
@@ -19,6 +20,7 @@
 #include "base/files/file_util.h"
 #include "base/functional/callback_helpers.h"
 #include "base/path_service.h"
+#include "base/process/process.h"
 #include "base/system/sys_info.h"
 #include "base/values.h"
 #include "base/win/windows_version.h"
@@ -38,6 +40,7 @@
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "crypto/crypto_buildflags.h"
 #include "electron/mas.h"
 #include "gin/handle.h"
@@ -79,6 +82,7 @@
 #include "shell/common/language_util.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_util.h"
 #include "ui/gfx/image/image.h"
@@ -1135,6 +1139,111 @@ void App::DisableDomainBlockingFor3DAPIs(gin_helper::ErrorThrower thrower) {
   }
 }
 
+void App::SetRendererProcessLimit(gin_helper::ErrorThrower thrower,
+                                  int limit) {
+  if (limit < 0) {
+    thrower.ThrowRangeError("limit must be a non-negative integer");
+    return;
+  }
+  // 0 restores Chromium's default, which is based on the amount of memory.
+  content::RenderProcessHost::SetMaxRendererProcessCount(
+      static_cast<size_t>(limit));
+  ElectronBrowserClient::Get()->set_has_renderer_process_limit(limit != 0);
+}
+
+base::Value::Dict App::GetStartupTimeline() const {
+  const std::vector<startup_timeline::Entry> entries =
+      startup_timeline::GetEntries();
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time wall_now = base::Time::Now();
+
+  // Times are relative to the creation of the process when the platform
+  // knows it, and to the first recorded entry otherwise.
+  base::TimeTicks origin = entries.empty() ? now : entries.front().start;
+  const base::Time creation_time = base::Process::Current().CreationTime();
+  if (!creation_time.is_null())
+    origin = std::min(origin, now - (wall_now - creation_time));
+
+  base::Value::List list;
+  for (const auto& entry : entries) {
+    list.Append(
+        base::Value::Dict()
+            .Set("name", entry.name)
+            .Set("startTime", (entry.start - origin).InMillisecondsF())
+            .Set("duration", (entry.end - entry.start).InMillisecondsF()));
+  }
+
+  return base::Value::Dict()
+      .Set("timeOrigin",
+           (wall_now - (now - origin)).InMillisecondsFSinceUnixEpoch())
+      .Set("entries", std::move(list));
+}
+
+void App::MarkStartup(const std::string& name) {
+  startup_timeline::Mark(name);
+}
+
+void App::StartJankDetection(gin::Arguments* args) {
+  if (jank_detector_) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("Jank detection is already running");
+    return;
+  }
+
+  double threshold = 100;
+  double stack_threshold = 1000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("threshold", &threshold);
+    options.Get("stackThreshold", &stack_threshold);
+  }
+  if (!(threshold > 0) || !(stack_threshold >= 0)) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError(
+            "threshold must be positive and stackThreshold can't be negative");
+    return;
+  }
+
+  JankDetector::Options detector_options;
+  detector_options.threshold = base::Milliseconds(threshold);
+  detector_options.stack_threshold = base::Milliseconds(stack_threshold);
+  jank_detector_ = std::make_unique<JankDetector>(
+      args->isolate(), detector_options,
+      base::BindRepeating(&App::OnLongTask, base::Unretained(this)));
+}
+
+void App::StopJankDetection() {
+  jank_detector_.reset();
+}
+
+base::Value::List App::GetJankHistogram() const {
+  base::Value::List buckets;
+  if (!jank_detector_)
+    return buckets;
+  const auto& histogram = jank_detector_->histogram();
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    buckets.Append(base::Value::Dict()
+                       .Set("start", JankDetector::kBucketBounds[i])
+                       .Set("count", histogram[i]));
+  }
+  return buckets;
+}
+
+void App::OnLongTask(const JankDetector::LongTask& task) {
+  const base::TimeDelta age = base::TimeTicks::Now() - task.start_time;
+  base::Value::Dict details =
+      base::Value::Dict()
+          .Set("startTime",
+               (base::Time::Now() - age).InMillisecondsFSinceUnixEpoch())
+          .Set("duration", task.duration.InMillisecondsF())
+          .Set("postedFrom", task.posted_from.ToString());
+  if (!task.attribution.empty())
+    details.Set("attribution", task.attribution);
+  if (!task.stack.empty())
+    details.Set("stack", task.stack);
+  Emit("main-thread-jank", std::move(details));
+}
+
 bool App::IsAccessibilitySupportEnabled() {
   auto* ax_state = content::BrowserAccessibilityState::GetInstance();
   return ax_state->IsAccessibleBrowser();
@@ -1795,6 +1904,12 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("setRendererProcessLimit", &App::SetRendererProcessLimit)
+      .SetMethod("getStartupTimeline", &App::GetStartupTimeline)
+      .SetMethod("_markStartup", &App::MarkStartup)
+      .SetMethod("startJankDetection", &App::StartJankDetection)
+      .SetMethod("stopJankDetection", &App::StopJankDetection)
+      .SetMethod("getJankHistogram", &App::GetJankHistogram)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if IS_MAS_BUILD()
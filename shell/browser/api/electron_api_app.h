@@ -25,6 +25,7 @@
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/jank_detector.h"
 
 #if BUILDFLAG(USE_NSS_CERTS)
 #include "shell/browser/certificate_manager_model.h"
@@ -215,6 +216,13 @@ class App final : public ElectronBrowserClient::Delegate,
   bool Relaunch(gin::Arguments* args);
   void DisableHardwareAcceleration(gin_helper::ErrorThrower thrower);
   void DisableDomainBlockingFor3DAPIs(gin_helper::ErrorThrower thrower);
+  void SetRendererProcessLimit(gin_helper::ErrorThrower thrower, int limit);
+  base::Value::Dict GetStartupTimeline() const;
+  void MarkStartup(const std::string& name);
+  void StartJankDetection(gin::Arguments* args);
+  void StopJankDetection();
+  base::Value::List GetJankHistogram() const;
+  void OnLongTask(const JankDetector::LongTask& task);
   bool IsAccessibilitySupportEnabled();
   void SetAccessibilitySupportEnabled(gin_helper::ErrorThrower thrower,
                                       bool enabled);
@@ -274,6 +282,8 @@ class App final : public ElectronBrowserClient::Delegate,
 
   base::FilePath app_path_;
 
+  std::unique_ptr<JankDetector> jank_detector_;
+
   // pid -> electron::ProcessMetric
   base::flat_map<content::ChildProcessId,
                  std::unique_ptr<electron::ProcessMetric>>
@@ -4,12 +4,19 @@
 
 #include "shell/browser/api/electron_api_cookies.h"
 
+#include <limits>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/containers/fixed_flat_set.h"
+#include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -102,68 +109,103 @@ namespace electron::api {
 
 namespace {
 
-// Returns whether |domain| matches |filter|.
-bool MatchesDomain(std::string filter, const std::string& domain) {
-  // Add a leading '.' character to the filter domain if it doesn't exist.
-  if (net::cookie_util::DomainIsHostOnly(filter))
-    filter.insert(0, ".");
+// A parsed |filter| argument of cookies.get(), so that matching a large
+// cookie jar does not repeat dictionary lookups for every cookie.
+struct CookieFilter {
+  std::optional<std::string> name;
+  std::optional<std::string> path;
+  // Always has a leading '.' character.
+  std::optional<std::string> domain;
+  std::optional<bool> secure;
+  std::optional<bool> session;
+  std::optional<bool> http_only;
+  // Number of matching cookies to skip, to page through a large jar.
+  size_t offset = 0;
+  size_t limit = std::numeric_limits<size_t>::max();
+};
 
-  std::string sub_domain(domain);
-  // Strip any leading '.' character from the input cookie domain.
-  if (!net::cookie_util::DomainIsHostOnly(sub_domain))
-    sub_domain = sub_domain.substr(1);
-
-  // Now check whether the domain argument is a subdomain of the filter domain.
-  for (sub_domain.insert(0, "."); sub_domain.length() >= filter.length();) {
-    if (sub_domain == filter)
-      return true;
-    const size_t next_dot = sub_domain.find('.', 1);  // Skip over leading dot.
-    sub_domain.erase(0, next_dot);
+CookieFilter ParseCookieFilter(const base::Value::Dict& dict) {
+  CookieFilter filter;
+  if (const std::string* str = dict.FindString("name"))
+    filter.name = *str;
+  if (const std::string* str = dict.FindString("path"))
+    filter.path = *str;
+  if (const std::string* str = dict.FindString("domain")) {
+    // Add a leading '.' character to the filter domain if it doesn't exist.
+    filter.domain = *str;
+    if (net::cookie_util::DomainIsHostOnly(*str))
+      filter.domain->insert(0, ".");
   }
-  return false;
+  filter.secure = dict.FindBool("secure");
+  filter.session = dict.FindBool("session");
+  filter.http_only = dict.FindBool("httpOnly");
+  std::optional<int> offset = dict.FindInt("offset");
+  if (offset && *offset >= 0)
+    filter.offset = static_cast<size_t>(*offset);
+  std::optional<int> limit = dict.FindInt("limit");
+  if (limit && *limit >= 0)
+    filter.limit = static_cast<size_t>(*limit);
+  return filter;
+}
+
+// Returns whether |domain| matches |filter|, which has a leading '.'.
+bool MatchesDomain(const std::string& filter, const std::string& domain) {
+  std::string_view sub_domain = domain;
+  // Strip any leading '.' character from the input cookie domain.
+  if (!net::cookie_util::DomainIsHostOnly(domain))
+    sub_domain.remove_prefix(1);
+
+  // The domain matches if it is equal to the filter domain, or if it is a
+  // subdomain of it. Since |filter| starts with '.', a suffix match always
+  // falls on a label boundary.
+  if (sub_domain.size() + 1 == filter.size())
+    return std::string_view(filter).substr(1) == sub_domain;
+  return base::EndsWith(sub_domain, filter);
 }
 
 // Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::Value::Dict& filter,
+bool MatchesCookie(const CookieFilter& filter,
                    const net::CanonicalCookie& cookie) {
-  const std::string* str;
-  if ((str = filter.FindString("name")) && *str != cookie.Name())
+  if (filter.name && *filter.name != cookie.Name())
     return false;
-  if ((str = filter.FindString("path")) && *str != cookie.Path())
+  if (filter.path && *filter.path != cookie.Path())
     return false;
-  if ((str = filter.FindString("domain")) &&
-      !MatchesDomain(*str, cookie.Domain()))
+  if (filter.domain && !MatchesDomain(*filter.domain, cookie.Domain()))
     return false;
-  std::optional<bool> secure_filter = filter.FindBool("secure");
-  if (secure_filter && *secure_filter != cookie.SecureAttribute())
+  if (filter.secure && *filter.secure != cookie.SecureAttribute())
     return false;
-  std::optional<bool> session_filter = filter.FindBool("session");
-  if (session_filter && *session_filter == cookie.IsPersistent())
+  if (filter.session && *filter.session == cookie.IsPersistent())
     return false;
-  std::optional<bool> httpOnly_filter = filter.FindBool("httpOnly");
-  if (httpOnly_filter && *httpOnly_filter != cookie.IsHttpOnly())
+  if (filter.http_only && *filter.http_only != cookie.IsHttpOnly())
     return false;
   return true;
 }
 
 // Remove cookies from |list| not matching |filter|, and pass it to |callback|.
-void FilterCookies(base::Value::Dict filter,
+void FilterCookies(const CookieFilter& filter,
                    gin_helper::Promise<net::CookieList> promise,
                    const net::CookieList& cookies) {
   net::CookieList result;
+  size_t skipped = 0;
   for (const auto& cookie : cookies) {
-    if (MatchesCookie(filter, cookie))
+    if (result.size() >= filter.limit)
+      break;
+    if (!MatchesCookie(filter, cookie))
+      continue;
+    if (skipped < filter.offset)
+      ++skipped;
+    else
       result.push_back(cookie);
   }
   promise.Resolve(result);
 }
 
 void FilterCookieWithStatuses(
-    base::Value::Dict filter,
+    const CookieFilter& filter,
     gin_helper::Promise<net::CookieList> promise,
     const net::CookieAccessResultList& list,
     const net::CookieAccessResultList& excluded_list) {
-  FilterCookies(std::move(filter), std::move(promise),
+  FilterCookies(filter, std::move(promise),
                 net::cookie_util::StripAccessResults(list));
 }
 
@@ -291,6 +333,70 @@ std::string StringToCookieSameSite(const std::string* str_ptr,
   return "";
 }
 
+// Creates the cookie described by the |details| argument of cookies.set().
+// Returns nullptr and sets |error| if |details| is invalid.
+std::unique_ptr<net::CanonicalCookie> CookieFromDetails(
+    const base::Value::Dict& details,
+    GURL* url,
+    std::string* error) {
+  const std::string* url_string = details.FindString("url");
+  if (!url_string) {
+    *error = "Missing required option 'url'";
+    return nullptr;
+  }
+  const std::string* name = details.FindString("name");
+  const std::string* value = details.FindString("value");
+  const std::string* domain = details.FindString("domain");
+  const std::string* path = details.FindString("path");
+  bool http_only = details.FindBool("httpOnly").value_or(false);
+  const std::string* same_site_string = details.FindString("sameSite");
+  net::CookieSameSite same_site;
+  *error = StringToCookieSameSite(same_site_string, &same_site);
+  if (!error->empty())
+    return nullptr;
+  bool secure = details.FindBool("secure").value_or(
+      same_site == net::CookieSameSite::NO_RESTRICTION);
+
+  *url = GURL(*url_string);
+  if (!url->is_valid()) {
+    net::CookieInclusionStatus cookie_inclusion_status;
+    cookie_inclusion_status.AddExclusionReason(
+        net::CookieInclusionStatus::ExclusionReason::EXCLUDE_INVALID_DOMAIN);
+    *error = InclusionStatusToString(cookie_inclusion_status);
+    return nullptr;
+  }
+
+  net::CookieInclusionStatus status;
+  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      *url, name ? *name : "", value ? *value : "", domain ? *domain : "",
+      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
+      ParseTimeProperty(details.FindDouble("expirationDate")),
+      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
+      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, std::nullopt,
+      &status);
+
+  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
+    net::CookieInclusionStatus cookie_inclusion_status;
+    cookie_inclusion_status.AddExclusionReason(
+        net::CookieInclusionStatus::ExclusionReason::EXCLUDE_FAILURE_TO_STORE);
+    *error = InclusionStatusToString(
+        !status.IsInclude() ? status : cookie_inclusion_status);
+    return nullptr;
+  }
+
+  return canonical_cookie;
+}
+
+net::CookieOptions CookieOptionsForSet(const net::CanonicalCookie& cookie) {
+  net::CookieOptions options;
+  if (cookie.IsHttpOnly()) {
+    options.set_include_httponly();
+  }
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+  return options;
+}
+
 }  // namespace
 
 gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -315,12 +421,13 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
 
   base::Value::Dict dict;
   gin::ConvertFromV8(isolate, filter.GetHandle(), &dict);
+  CookieFilter cookie_filter = ParseCookieFilter(dict);
 
   std::string url;
   filter.Get("url", &url);
   if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
+    manager->GetAllCookies(base::BindOnce(
+        &FilterCookies, std::move(cookie_filter), std::move(promise)));
   } else {
     net::CookieOptions options;
     options.set_include_httponly();
@@ -331,7 +438,8 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
     manager->GetCookieList(GURL(url), options,
                            net::CookiePartitionKeyCollection::Todo(),
                            base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
+                                          std::move(cookie_filter),
+                                          std::move(promise)));
   }
 
   return handle;
@@ -361,70 +469,81 @@ v8::Local<v8::Promise> Cookies::Remove(v8::Isolate* isolate,
   return handle;
 }
 
-v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
-                                    base::Value::Dict details) {
-  gin_helper::Promise<void> promise(isolate);
+v8::Local<v8::Promise> Cookies::RemoveMatching(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& filter) {
+  gin_helper::Promise<uint32_t> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindString("url");
-  if (!url_string) {
-    promise.RejectWithErrorMessage("Missing required option 'url'");
-    return handle;
+  // A misspelled or missing criterion must not wipe the whole cookie jar.
+  base::Value::Dict dict;
+  gin::ConvertFromV8(isolate, filter.GetHandle(), &dict);
+  static constexpr auto kCriteria = base::MakeFixedFlatSet<std::string_view>(
+      {"domains", "name", "session", "url"});
+  for (const auto [key, value] : dict) {
+    if (!kCriteria.contains(key)) {
+      promise.RejectWithErrorMessage("Unknown filter property '" + key + "'");
+      return handle;
+    }
   }
-  const std::string* name = details.FindString("name");
-  const std::string* value = details.FindString("value");
-  const std::string* domain = details.FindString("domain");
-  const std::string* path = details.FindString("path");
-  bool http_only = details.FindBool("httpOnly").value_or(false);
-  const std::string* same_site_string = details.FindString("sameSite");
-  net::CookieSameSite same_site;
-  std::string error = StringToCookieSameSite(same_site_string, &same_site);
-  if (!error.empty()) {
-    promise.RejectWithErrorMessage(error);
+  if (dict.empty()) {
+    promise.RejectWithErrorMessage(
+        "The filter needs at least one of 'url', 'name', 'domains' or "
+        "'session'");
     return handle;
   }
-  bool secure = details.FindBool("secure").value_or(
-      same_site == net::CookieSameSite::NO_RESTRICTION);
 
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    net::CookieInclusionStatus cookie_inclusion_status;
-    cookie_inclusion_status.AddExclusionReason(
-        net::CookieInclusionStatus::ExclusionReason::EXCLUDE_INVALID_DOMAIN);
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(cookie_inclusion_status));
-    return handle;
+  // All matching cookies are deleted by the network service in a single call,
+  // rather than one call per cookie.
+  auto cookie_deletion_filter = network::mojom::CookieDeletionFilter::New();
+  GURL url;
+  if (filter.Get("url", &url))
+    cookie_deletion_filter->url = url;
+  std::string name;
+  if (filter.Get("name", &name))
+    cookie_deletion_filter->cookie_name = name;
+  std::vector<std::string> domains;
+  if (filter.Get("domains", &domains))
+    cookie_deletion_filter->including_domains = std::move(domains);
+  bool session;
+  if (filter.Get("session", &session)) {
+    cookie_deletion_filter->session_control =
+        session ? network::mojom::CookieDeletionSessionControl::SESSION_COOKIES
+                : network::mojom::CookieDeletionSessionControl::
+                      PERSISTENT_COOKIES;
   }
 
-  net::CookieInclusionStatus status;
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
-      ParseTimeProperty(details.FindDouble("expirationDate")),
-      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
-      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, std::nullopt,
-      &status);
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
 
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    net::CookieInclusionStatus cookie_inclusion_status;
-    cookie_inclusion_status.AddExclusionReason(
-        net::CookieInclusionStatus::ExclusionReason::EXCLUDE_FAILURE_TO_STORE);
-    promise.RejectWithErrorMessage(InclusionStatusToString(
-        !status.IsInclude() ? status : cookie_inclusion_status));
-    return handle;
-  }
+  manager->DeleteCookies(
+      std::move(cookie_deletion_filter),
+      base::BindOnce(
+          [](gin_helper::Promise<uint32_t> promise, uint32_t num_deleted) {
+            promise.Resolve(num_deleted);
+          },
+          std::move(promise)));
 
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
+                                    base::Value::Dict details) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  GURL url;
+  std::string error;
+  auto canonical_cookie = CookieFromDetails(details, &url, &error);
+  if (!canonical_cookie) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
   }
-  options.set_same_site_cookie_context(
-      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
 
   auto* storage_partition = browser_context_->GetDefaultStoragePartition();
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
   manager->SetCanonicalCookie(
-      *canonical_cookie, url, options,
+      *canonical_cookie, url, CookieOptionsForSet(*canonical_cookie),
       base::BindOnce(
           [](gin_helper::Promise<void> promise, net::CookieAccessResult r) {
             if (r.status.IsInclude()) {
@@ -438,6 +557,57 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   return handle;
 }
 
+v8::Local<v8::Promise> Cookies::SetMany(v8::Isolate* isolate,
+                                        base::Value::List details_list) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Validate every cookie up front so that an invalid entry does not leave
+  // the jar partially written.
+  std::vector<std::pair<GURL, std::unique_ptr<net::CanonicalCookie>>> cookies;
+  cookies.reserve(details_list.size());
+  for (const auto& details : details_list) {
+    if (!details.is_dict()) {
+      promise.RejectWithErrorMessage("Each cookie must be an object");
+      return handle;
+    }
+    GURL url;
+    std::string error;
+    auto canonical_cookie = CookieFromDetails(details.GetDict(), &url, &error);
+    if (!canonical_cookie) {
+      promise.RejectWithErrorMessage(error);
+      return handle;
+    }
+    cookies.emplace_back(std::move(url), std::move(canonical_cookie));
+  }
+
+  auto on_all_set = base::BarrierCallback<const net::CookieAccessResult&>(
+      cookies.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise,
+             std::vector<net::CookieAccessResult> results) {
+            for (const auto& r : results) {
+              if (!r.status.IsInclude()) {
+                promise.RejectWithErrorMessage(
+                    InclusionStatusToString(r.status));
+                return;
+              }
+            }
+            promise.Resolve();
+          },
+          std::move(promise)));
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  for (const auto& [url, canonical_cookie] : cookies) {
+    manager->SetCanonicalCookie(*canonical_cookie, url,
+                                CookieOptionsForSet(*canonical_cookie),
+                                on_all_set);
+  }
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -472,7 +642,9 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
              isolate)
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
+      .SetMethod("removeMatching", &Cookies::RemoveMatching)
       .SetMethod("set", &Cookies::Set)
+      .SetMethod("setMany", &Cookies::SetMany)
       .SetMethod("flushStore", &Cookies::FlushStore);
 }
 
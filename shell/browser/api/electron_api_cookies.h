@@ -56,9 +56,12 @@ class Cookies final : public gin::Wrappable<Cookies>,
   v8::Local<v8::Promise> Get(v8::Isolate*,
                              const gin_helper::Dictionary& filter);
   v8::Local<v8::Promise> Set(v8::Isolate*, base::Value::Dict details);
+  v8::Local<v8::Promise> SetMany(v8::Isolate*, base::Value::List details_list);
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
+  v8::Local<v8::Promise> RemoveMatching(v8::Isolate*,
+                                        const gin_helper::Dictionary& filter);
   v8::Local<v8::Promise> FlushStore(v8::Isolate*);
 
   // CookieChangeNotifier subscription:
@@ -4,9 +4,12 @@
 
 #include "shell/browser/api/electron_api_download_item.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "base/functional/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "gin/data_object_builder.h"
 #include "gin/handle.h"
 #include "net/base/filename_util.h"
 #include "shell/browser/electron_browser_main_parts.h"
@@ -107,18 +110,66 @@ void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
   if (!CheckAlive())
     return;
   if (download_item_->IsDone()) {
+    update_timer_.Stop();
     Emit("done", item->GetState());
     Unpin();
-  } else {
-    Emit("updated", item->GetState());
+    return;
   }
+
+  // State changes are always reported right away, only progress is coalesced.
+  if (update_interval_.is_zero() || item->GetState() != last_state_ ||
+      item->IsPaused() != last_paused_) {
+    EmitUpdated();
+    return;
+  }
+
+  if (update_timer_.IsRunning())
+    return;
+  const base::TimeDelta delay =
+      last_update_time_ + update_interval_ - base::TimeTicks::Now();
+  if (!delay.is_positive()) {
+    EmitUpdated();
+    return;
+  }
+  update_timer_.Start(
+      FROM_HERE, delay,
+      base::BindOnce(&DownloadItem::EmitUpdated, base::Unretained(this)));
 }
 
 void DownloadItem::OnDownloadDestroyed(download::DownloadItem* /*item*/) {
+  update_timer_.Stop();
   download_item_ = nullptr;
   Unpin();
 }
 
+void DownloadItem::EmitUpdated() {
+  update_timer_.Stop();
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const int64_t received_bytes = download_item_->GetReceivedBytes();
+  // A download that is resumed after an interruption can start over from
+  // scratch, in which case everything it has received is new.
+  const int64_t delta_bytes = received_bytes >= last_received_bytes_
+                                  ? received_bytes - last_received_bytes_
+                                  : received_bytes;
+  double bytes_per_second = 0;
+  if (!last_update_time_.is_null() && now > last_update_time_)
+    bytes_per_second = delta_bytes / (now - last_update_time_).InSecondsF();
+
+  last_update_time_ = now;
+  last_received_bytes_ = received_bytes;
+  last_state_ = download_item_->GetState();
+  last_paused_ = download_item_->IsPaused();
+
+  v8::HandleScope handle_scope(isolate_);
+  auto progress = gin::DataObjectBuilder(isolate_)
+                      .Set("receivedBytes", received_bytes)
+                      .Set("deltaBytes", delta_bytes)
+                      .Set("bytesPerSecond", bytes_per_second)
+                      .Build();
+  Emit("updated", last_state_, progress);
+}
+
 void DownloadItem::Pause() {
   if (!CheckAlive())
     return;
@@ -266,6 +317,14 @@ double DownloadItem::GetEndTime() const {
   return download_item_->GetEndTime().InSecondsFSinceUnixEpoch();
 }
 
+void DownloadItem::SetUpdateInterval(int interval_ms) {
+  update_interval_ = base::Milliseconds(std::max(interval_ms, 0));
+}
+
+int DownloadItem::GetUpdateInterval() const {
+  return update_interval_.InMilliseconds();
+}
+
 // static
 gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
@@ -298,7 +357,9 @@ gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
       .SetMethod("getLastModifiedTime", &DownloadItem::GetLastModifiedTime)
       .SetMethod("getETag", &DownloadItem::GetETag)
       .SetMethod("getStartTime", &DownloadItem::GetStartTime)
-      .SetMethod("getEndTime", &DownloadItem::GetEndTime);
+      .SetMethod("getEndTime", &DownloadItem::GetEndTime)
+      .SetMethod("setUpdateInterval", &DownloadItem::SetUpdateInterval)
+      .SetMethod("getUpdateInterval", &DownloadItem::GetUpdateInterval);
 }
 
 const char* DownloadItem::GetTypeName() {
@@ -10,6 +10,8 @@
 #include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/download/public/common/download_item.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
@@ -60,6 +62,9 @@ class DownloadItem final : public gin::Wrappable<DownloadItem>,
   void OnDownloadUpdated(download::DownloadItem* item) override;
   void OnDownloadDestroyed(download::DownloadItem* item) override;
 
+  // Emits 'updated' with the progress made since the last emission.
+  void EmitUpdated();
+
   // JS API
   void Pause();
   bool IsPaused() const;
@@ -83,6 +88,8 @@ class DownloadItem final : public gin::Wrappable<DownloadItem>,
   std::string GetETag() const;
   double GetStartTime() const;
   double GetEndTime() const;
+  void SetUpdateInterval(int interval_ms);
+  int GetUpdateInterval() const;
 
   base::FilePath save_path_;
   file_dialog::DialogSettings dialog_options_;
@@ -90,6 +97,16 @@ class DownloadItem final : public gin::Wrappable<DownloadItem>,
 
   raw_ptr<v8::Isolate> isolate_;
 
+  // Minimum time between two progress-only 'updated' events. Zero means
+  // every update of the underlying download is reported.
+  base::TimeDelta update_interval_;
+  base::OneShotTimer update_timer_;
+  base::TimeTicks last_update_time_;
+  int64_t last_received_bytes_ = 0;
+  download::DownloadItem::DownloadState last_state_ =
+      download::DownloadItem::IN_PROGRESS;
+  bool last_paused_ = false;
+
   base::WeakPtrFactory<DownloadItem> weak_factory_{this};
 };
 
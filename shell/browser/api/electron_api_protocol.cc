@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_protocol.h"
 
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "base/command_line.h"
@@ -15,9 +16,13 @@
 #include "gin/object_template_builder.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
+#include "shell/browser/net/protocol_response_cache.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/optional_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/gin_helper/promise.h"
@@ -194,6 +199,8 @@ const char* const kBuiltinSchemes[] = {
     "about", "file", "http", "https", "data", "filesystem",
 };
 
+constexpr double kDefaultResponseCacheSize = 64 * 1024 * 1024;
+
 // Convert error code to string.
 constexpr std::string_view ErrorCodeToString(ProtocolError error) {
   switch (error) {
@@ -255,6 +262,101 @@ bool Protocol::IsProtocolIntercepted(const std::string& scheme) {
   return protocol_registry_->FindIntercepted(scheme) != nullptr;
 }
 
+void Protocol::Mount(gin_helper::ErrorThrower thrower,
+                     const std::string& scheme,
+                     const gin_helper::Dictionary& options) {
+  if (base::Contains(kBuiltinSchemes, scheme)) {
+    thrower.ThrowError("Directories cannot be mounted on built-in schemes");
+    return;
+  }
+
+  DirectoryMount mount;
+  if (!options.Get("path", &mount.root) || !mount.root.IsAbsolute()) {
+    thrower.ThrowTypeError("'path' must be an absolute path");
+    return;
+  }
+
+  std::string host;
+  options.Get("host", &host);
+
+  base::Value::Dict headers;
+  if (options.Get("headers", &headers)) {
+    for (const auto [name, value] : headers) {
+      if (!value.is_string()) {
+        thrower.ThrowTypeError("Header values must be strings");
+        return;
+      }
+      mount.headers.emplace_back(name, value.GetString());
+    }
+  }
+
+  if (!protocol_registry_->MountDirectory(scheme, host, std::move(mount))) {
+    thrower.ThrowError("A directory is already mounted on " + scheme + "://" +
+                       host);
+  }
+}
+
+void Protocol::Unmount(gin_helper::ErrorThrower thrower,
+                       const std::string& scheme,
+                       gin::Arguments* args) {
+  std::string host;
+  args->GetNext(&host);
+  if (!protocol_registry_->UnmountDirectory(scheme, host)) {
+    thrower.ThrowError("No directory is mounted on " + scheme + "://" + host);
+  }
+}
+
+void Protocol::EnableResponseCache(gin_helper::ErrorThrower thrower,
+                                   const std::string& scheme,
+                                   gin::Arguments* args) {
+  double max_size = kDefaultResponseCacheSize;
+  if (gin_helper::Dictionary options; args->GetNext(&options))
+    options.Get("maxSize", &max_size);
+  if (!(max_size > 0)) {
+    thrower.ThrowTypeError("'maxSize' must be a positive number");
+    return;
+  }
+
+  if (!protocol_registry_->EnableResponseCache(
+          scheme, static_cast<size_t>(max_size))) {
+    thrower.ThrowError("The response cache is already enabled for " + scheme);
+  }
+}
+
+void Protocol::DisableResponseCache(gin_helper::ErrorThrower thrower,
+                                    const std::string& scheme) {
+  if (!protocol_registry_->DisableResponseCache(scheme))
+    thrower.ThrowError("The response cache is not enabled for " + scheme);
+}
+
+std::optional<double> Protocol::GetResponseCacheMaxSize(
+    const std::string& scheme) {
+  const ProtocolResponseCache* cache =
+      protocol_registry_->FindResponseCache(scheme);
+  if (!cache)
+    return std::nullopt;
+  return static_cast<double>(cache->max_size());
+}
+
+std::optional<base::Value::Dict> Protocol::GetResponseCacheStats(
+    const std::string& scheme) {
+  const ProtocolResponseCache* cache =
+      protocol_registry_->FindResponseCache(scheme);
+  if (!cache)
+    return std::nullopt;
+
+  const ProtocolResponseCache::Stats stats = cache->GetStats();
+  const double lookups = static_cast<double>(stats.hits + stats.misses);
+  return base::Value::Dict()
+      .Set("hits", static_cast<double>(stats.hits))
+      .Set("misses", static_cast<double>(stats.misses))
+      .Set("revalidations", static_cast<double>(stats.revalidations))
+      .Set("hitRate", lookups > 0 ? stats.hits / lookups : 0)
+      .Set("entryCount", static_cast<double>(stats.entry_count))
+      .Set("size", static_cast<double>(stats.size))
+      .Set("maxSize", static_cast<double>(stats.max_size));
+}
+
 v8::Local<v8::Promise> Protocol::IsProtocolHandled(const std::string& scheme,
                                                    gin::Arguments* args) {
   util::EmitWarning(args->isolate(),
@@ -339,6 +441,13 @@ v8::Local<v8::ObjectTemplate> Protocol::FillObjectTemplate(
                  &Protocol::InterceptProtocolFor<ProtocolType::kFree>)
       .SetMethod("uninterceptProtocol", &Protocol::UninterceptProtocol)
       .SetMethod("isProtocolIntercepted", &Protocol::IsProtocolIntercepted)
+      .SetMethod("mount", &Protocol::Mount)
+      .SetMethod("unmount", &Protocol::Unmount)
+      .SetMethod("enableResponseCache", &Protocol::EnableResponseCache)
+      .SetMethod("disableResponseCache", &Protocol::DisableResponseCache)
+      .SetMethod("_getResponseCacheMaxSize",
+                 &Protocol::GetResponseCacheMaxSize)
+      .SetMethod("getResponseCacheStats", &Protocol::GetResponseCacheStats)
       .Build();
 }
 
@@ -5,10 +5,12 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_PROTOCOL_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_PROTOCOL_H_
 
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/values.h"
 #include "content/public/browser/content_browser_client.h"
 #include "gin/wrappable.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
@@ -20,6 +22,10 @@ template <typename T>
 class Handle;
 }  // namespace gin
 
+namespace gin_helper {
+class Dictionary;
+}  // namespace gin_helper
+
 namespace electron {
 
 class ElectronBrowserContext;
@@ -83,6 +89,22 @@ class Protocol final : public gin::Wrappable<Protocol>,
   bool UninterceptProtocol(const std::string& scheme, gin::Arguments* args);
   bool IsProtocolIntercepted(const std::string& scheme);
 
+  void Mount(gin_helper::ErrorThrower thrower,
+             const std::string& scheme,
+             const gin_helper::Dictionary& options);
+  void Unmount(gin_helper::ErrorThrower thrower,
+               const std::string& scheme,
+               gin::Arguments* args);
+
+  void EnableResponseCache(gin_helper::ErrorThrower thrower,
+                           const std::string& scheme,
+                           gin::Arguments* args);
+  void DisableResponseCache(gin_helper::ErrorThrower thrower,
+                            const std::string& scheme);
+  std::optional<double> GetResponseCacheMaxSize(const std::string& scheme);
+  std::optional<base::Value::Dict> GetResponseCacheStats(
+      const std::string& scheme);
+
   // Old async version of IsProtocolRegistered.
   v8::Local<v8::Promise> IsProtocolHandled(const std::string& scheme,
                                            gin::Arguments* args);
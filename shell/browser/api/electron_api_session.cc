@@ -38,6 +38,7 @@
 #include "content/public/browser/download_item_utils.h"
 #include "content/public/browser/download_manager_delegate.h"
 #include "content/public/browser/network_service_instance.h"
+#include "content/public/browser/site_instance.h"
 #include "content/public/browser/storage_partition.h"
 #include "gin/arguments.h"
 #include "gin/converter.h"
@@ -66,14 +67,17 @@
 #include "shell/browser/api/electron_api_web_frame_main.h"
 #include "shell/browser/api/electron_api_web_request.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/console_log_sink.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/browser/log_pref_store.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
 #include "shell/browser/net/resolve_host_function.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -981,10 +985,93 @@ std::string Session::GetUserAgent() {
   return browser_context_->GetUserAgent();
 }
 
+void Session::SetProcessPerSiteOrigins(gin_helper::ErrorThrower thrower,
+                                       const std::vector<GURL>& origins) {
+  std::vector<GURL> sites;
+  sites.reserve(origins.size());
+  for (const GURL& origin : origins) {
+    if (!origin.is_valid()) {
+      thrower.ThrowError("Invalid origin: \"" + origin.possibly_invalid_spec() +
+                         "\"");
+      return;
+    }
+    sites.push_back(
+        content::SiteInstance::GetSiteForURL(&browser_context_.get(), origin));
+  }
+  browser_context_->set_process_per_site_sites(
+      base::flat_set<GURL>(std::move(sites)));
+}
+
+std::vector<GURL> Session::GetProcessPerSiteOrigins() const {
+  const auto& sites = browser_context_->process_per_site_sites();
+  return {sites.begin(), sites.end()};
+}
+
 void Session::SetSSLConfig(network::mojom::SSLConfigPtr config) {
   browser_context_->SetSSLConfig(std::move(config));
 }
 
+void Session::SetConsoleLogSink(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || value->IsNull()) {
+    browser_context_->SetConsoleLogSink(nullptr);
+    return;
+  }
+
+  gin_helper::Dictionary options;
+  if (!gin::ConvertFromV8(args->isolate(), value, &options)) {
+    args->ThrowTypeError("Must pass null or an options object");
+    return;
+  }
+
+  ConsoleLogSink::Options sink_options;
+  sink_options.is_pipe = options.Get("pipe", &sink_options.path);
+  if (!sink_options.is_pipe)
+    options.Get("path", &sink_options.path);
+  if (!sink_options.path.IsAbsolute()) {
+    args->ThrowTypeError("Absolute path or pipe must be provided");
+    return;
+  }
+
+  if (options.Has("maxFileSize") &&
+      (!options.Get("maxFileSize", &sink_options.max_file_size) ||
+       sink_options.max_file_size <= 0)) {
+    args->ThrowTypeError("maxFileSize must be a positive number");
+    return;
+  }
+  if (options.Has("maxFiles") &&
+      (!options.Get("maxFiles", &sink_options.max_files) ||
+       sink_options.max_files <= 0)) {
+    args->ThrowTypeError("maxFiles must be a positive number");
+    return;
+  }
+
+  std::vector<blink::mojom::ConsoleMessageLevel> levels;
+  if (options.Has("levels") && !options.Get("levels", &levels)) {
+    args->ThrowTypeError(
+        "levels must only contain 'debug', 'info', 'warning' or 'error'");
+    return;
+  }
+  sink_options.levels = base::flat_set<blink::mojom::ConsoleMessageLevel>(
+      std::move(levels));
+
+  options.Get("sourcePattern", &sink_options.source_pattern);
+
+  double flush_interval;
+  if (options.Get("flushInterval", &flush_interval)) {
+    if (flush_interval < 0) {
+      args->ThrowTypeError("flushInterval must not be negative");
+      return;
+    }
+    sink_options.flush_interval = base::Milliseconds(flush_interval);
+  }
+
+  options.Get("emitEvents", &sink_options.emit_events);
+
+  browser_context_->SetConsoleLogSink(
+      std::make_unique<ConsoleLogSink>(std::move(sink_options)));
+}
+
 bool Session::IsPersistent() {
   return !browser_context_->IsOffTheRecord();
 }
@@ -1399,6 +1486,23 @@ v8::Local<v8::Value> Session::GetPath(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, browser_context_->GetPath());
 }
 
+v8::Local<v8::Value> Session::GetPreferencesStoreMetrics(
+    v8::Isolate* isolate) {
+  LogPrefStore* store = browser_context_->log_pref_store();
+  if (!store)
+    return v8::Null(isolate);
+  const LogPrefStore::Metrics metrics = store->metrics();
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("writeCount", metrics.write_count);
+  dict.Set("writeBytes", metrics.write_bytes);
+  dict.Set("writeTime", metrics.write_time.InMillisecondsF());
+  dict.Set("compactionCount", metrics.compaction_count);
+  dict.Set("compactionBytes", metrics.compaction_bytes);
+  dict.Set("compactionTime", metrics.compaction_time.InMillisecondsF());
+  dict.Set("logSize", metrics.log_size);
+  return dict.GetHandle();
+}
+
 void Session::SetCodeCachePath(gin::Arguments* args) {
   base::FilePath code_cache_path;
   auto* storage_partition = browser_context_->GetDefaultStoragePartition();
@@ -1759,7 +1863,10 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("isPersistent", &Session::IsPersistent)
       .SetMethod("setUserAgent", &Session::SetUserAgent)
       .SetMethod("getUserAgent", &Session::GetUserAgent)
+      .SetMethod("setProcessPerSiteOrigins", &Session::SetProcessPerSiteOrigins)
+      .SetMethod("getProcessPerSiteOrigins", &Session::GetProcessPerSiteOrigins)
       .SetMethod("setSSLConfig", &Session::SetSSLConfig)
+      .SetMethod("setConsoleLogSink", &Session::SetConsoleLogSink)
       .SetMethod("getBlobData", &Session::GetBlobData)
       .SetMethod("downloadURL", &Session::DownloadURL)
       .SetMethod("createInterruptedDownload",
@@ -1795,6 +1902,8 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("preconnect", &Session::Preconnect)
       .SetMethod("closeAllConnections", &Session::CloseAllConnections)
       .SetMethod("getStoragePath", &Session::GetPath)
+      .SetMethod("getPreferencesStoreMetrics",
+                 &Session::GetPreferencesStoreMetrics)
       .SetMethod("setCodeCachePath", &Session::SetCodeCachePath)
       .SetMethod("clearCodeCaches", &Session::ClearCodeCaches)
       .SetMethod("clearData", &Session::ClearData)
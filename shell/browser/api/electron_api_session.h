@@ -130,7 +130,11 @@ class Session final : public gin::Wrappable<Session>,
   void AllowNTLMCredentialsForDomains(const std::string& domains);
   void SetUserAgent(const std::string& user_agent, gin::Arguments* args);
   std::string GetUserAgent();
+  void SetProcessPerSiteOrigins(gin_helper::ErrorThrower thrower,
+                                const std::vector<GURL>& origins);
+  std::vector<GURL> GetProcessPerSiteOrigins() const;
   void SetSSLConfig(network::mojom::SSLConfigPtr config);
+  void SetConsoleLogSink(gin::Arguments* args);
   bool IsPersistent();
   v8::Local<v8::Promise> GetBlobData(v8::Isolate* isolate,
                                      const std::string& uuid);
@@ -156,6 +160,7 @@ class Session final : public gin::Wrappable<Session>,
   void Preconnect(const gin_helper::Dictionary& options, gin::Arguments* args);
   v8::Local<v8::Promise> CloseAllConnections();
   v8::Local<v8::Value> GetPath(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetPreferencesStoreMetrics(v8::Isolate* isolate);
   void SetCodeCachePath(gin::Arguments* args);
   v8::Local<v8::Promise> ClearCodeCaches(const gin_helper::Dictionary& options);
   v8::Local<v8::Value> ClearData(gin_helper::ErrorThrower thrower,
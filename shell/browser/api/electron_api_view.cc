@@ -7,7 +7,9 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "ash/style/rounded_rect_cutout_path_builder.h"
@@ -169,6 +171,22 @@ class JSLayoutManager : public views::LayoutManagerBase {
   LayoutCallback layout_callback_;
 };
 
+// Reads the optional |key| of |dict| into |out|. Returns false when the key
+// is set to something that can't be converted.
+template <typename T>
+bool GetOptionalStrict(const gin_helper::Dictionary& dict,
+                       std::string_view key,
+                       std::optional<T>* out) {
+  v8::Local<v8::Value> value;
+  if (!dict.Get(key, &value) || value->IsUndefined())
+    return true;
+  T converted;
+  if (!gin::ConvertFromV8(dict.isolate(), value, &converted))
+    return false;
+  out->emplace(std::move(converted));
+  return true;
+}
+
 View::View(views::View* view) : view_(view) {
   view_->set_owned_by_client();
   view_->AddObserver(this);
@@ -392,8 +410,96 @@ bool View::GetVisible() const {
   return view_ ? view_->GetVisible() : false;
 }
 
+void View::BatchUpdate(const std::vector<gin_helper::Dictionary>& updates) {
+  if (!view_)
+    return;
+
+  // Validate everything up front so that a bad entry leaves the tree
+  // untouched rather than half-updated.
+  struct ChildUpdate {
+    gin::Handle<View> child;
+    std::optional<int> index;
+    std::optional<bool> visible;
+    std::optional<gfx::Rect> bounds;
+  };
+  gin_helper::ErrorThrower thrower(isolate());
+  std::vector<ChildUpdate> child_updates;
+  child_updates.reserve(updates.size());
+  for (const auto& update : updates) {
+    ChildUpdate child_update;
+    if (!update.Get("view", &child_update.child) ||
+        !child_update.child->view()) {
+      thrower.ThrowTypeError("Each update must have a valid 'view'");
+      return;
+    }
+    if (child_update.child->view()->parent() != view_) {
+      thrower.ThrowError("Each updated view must be a child of this view");
+      return;
+    }
+    if (!GetOptionalStrict(update, "index", &child_update.index) ||
+        child_update.index.value_or(0) < 0) {
+      thrower.ThrowTypeError("'index' must be a non-negative integer");
+      return;
+    }
+    if (!GetOptionalStrict(update, "visible", &child_update.visible)) {
+      thrower.ThrowTypeError("'visible' must be a boolean");
+      return;
+    }
+    if (!GetOptionalStrict(update, "bounds", &child_update.bounds)) {
+      thrower.ThrowTypeError("'bounds' must be a Rectangle");
+      return;
+    }
+    child_updates.push_back(std::move(child_update));
+  }
+
+#if BUILDFLAG(IS_MAC)
+  // Also commits all the layer changes in a single CATransaction.
+  ScopedCAActionDisabler disable_animations;
+#endif
+
+  SuspendBoundsChangedEvents();
+  for (auto& child_update : child_updates)
+    child_update.child->SuspendBoundsChangedEvents();
+
+  for (auto& [child, index, visible, bounds] : child_updates) {
+    if (!child->view())
+      continue;
+    if (index) {
+      ReorderChildView(child, std::min(static_cast<size_t>(*index),
+                                       child_views_.size() - 1));
+    }
+    if (visible)
+      child->view()->SetVisible(*visible);
+    if (bounds)
+      child->view()->SetBoundsRect(*bounds);
+  }
+
+  // Listeners only run once every view has its final bounds.
+  for (auto& child_update : child_updates)
+    child_update.child->ResumeBoundsChangedEvents();
+  ResumeBoundsChangedEvents();
+}
+
+void View::SuspendBoundsChangedEvents() {
+  bounds_changed_suspended_ = true;
+}
+
+void View::ResumeBoundsChangedEvents() {
+  if (!bounds_changed_suspended_)
+    return;
+  bounds_changed_suspended_ = false;
+  if (bounds_changed_pending_) {
+    bounds_changed_pending_ = false;
+    Emit("bounds-changed");
+  }
+}
+
 void View::OnViewBoundsChanged(views::View* observed_view) {
   ApplyBorderRadius();
+  if (bounds_changed_suspended_) {
+    bounds_changed_pending_ = true;
+    return;
+  }
   Emit("bounds-changed");
 }
 
@@ -451,7 +557,8 @@ void View::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setBorderRadius", &View::SetBorderRadius)
       .SetMethod("setLayout", &View::SetLayout)
       .SetMethod("setVisible", &View::SetVisible)
-      .SetMethod("getVisible", &View::GetVisible);
+      .SetFastMethod<&View::GetVisible>("getVisible")
+      .SetMethod("batchUpdate", &View::BatchUpdate);
 }
 
 }  // namespace electron::api
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_VIEW_H_
 
 #include <optional>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "shell/common/color_util.h"
@@ -19,6 +20,10 @@ template <typename T>
 class Handle;
 }  // namespace gin
 
+namespace gin_helper {
+class Dictionary;
+}  // namespace gin_helper
+
 namespace electron::api {
 
 using ChildPair = std::pair<raw_ptr<views::View>, v8::Global<v8::Object>>;
@@ -46,6 +51,7 @@ class View : public gin_helper::EventEmitter<View>,
   void SetBorderRadius(int radius);
   void SetVisible(bool visible);
   bool GetVisible() const;
+  void BatchUpdate(const std::vector<gin_helper::Dictionary>& updates);
 
   // views::ViewObserver
   void OnViewBoundsChanged(views::View* observed_view) override;
@@ -72,9 +78,17 @@ class View : public gin_helper::EventEmitter<View>,
   void ApplyBorderRadius();
   void ReorderChildView(gin::Handle<View> child, size_t index);
 
+  // Holds back 'bounds-changed' while a batch update is being applied, and
+  // emits it at most once when released.
+  void SuspendBoundsChangedEvents();
+  void ResumeBoundsChangedEvents();
+
   std::vector<ChildPair> child_views_;
   std::optional<int> border_radius_;
 
+  bool bounds_changed_suspended_ = false;
+  bool bounds_changed_pending_ = false;
+
   bool delete_view_ = true;
   raw_ptr<views::View> view_ = nullptr;
 };
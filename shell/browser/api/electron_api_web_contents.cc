@@ -23,6 +23,7 @@
 #include "base/strings/strcat.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
@@ -91,6 +92,7 @@
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
+#include "shell/browser/console_log_sink.h"
 #include "shell/browser/electron_autofill_driver_factory.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
@@ -137,7 +139,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
-#include "shell/common/thread_restrictions.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/v8_util.h"
 #include "storage/browser/file_system/isolated_context.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
@@ -711,6 +713,58 @@ content::RenderFrameHost* GetRenderFrameHost(
 
   return frame_host;
 }
+
+// Opens |file_path| for a renderer to write heap profiling data to, then runs
+// |callback| with it on the current sequence. An existing FIFO or named pipe
+// is opened as is instead of being created. Opening a FIFO for writing blocks
+// until it has a reader, so it happens on a sequence that shutdown doesn't
+// wait for.
+void OpenHeapProfileFile(const base::FilePath& file_path,
+                         bool pipe,
+                         base::OnceCallback<void(base::File)> callback) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(
+          [](const base::FilePath& file_path, bool pipe) {
+            uint32_t flags =
+                pipe ? base::File::FLAG_OPEN | base::File::FLAG_WRITE
+                     : base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE;
+            // The file is passed to an untrusted process.
+            flags = base::File::AddFlagsForPassingToUntrustedProcess(flags);
+            return base::File(file_path, flags);
+          },
+          file_path, pipe),
+      std::move(callback));
+}
+
+// Binds the ElectronRenderer interface of the primary main frame, or rejects
+// |promise| with an error about failing to |action| when there is none.
+std::unique_ptr<mojo::Remote<mojom::ElectronRenderer>> BindMainFrameRenderer(
+    content::WebContents* web_contents,
+    gin_helper::Promise<void>& promise,
+    std::string_view action) {
+  auto* frame_host = web_contents->GetPrimaryMainFrame();
+  if (!frame_host) {
+    promise.RejectWithErrorMessage(base::StrCat(
+        {"Failed to ", action, " with invalid webContents main frame"}));
+    return nullptr;
+  }
+
+  if (!frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage(
+        base::StrCat({"Failed to ", action, " with nonexistent render frame"}));
+    return nullptr;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      electron_renderer->BindNewPipeAndPassReceiver());
+  return electron_renderer;
+}
+
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -1117,6 +1171,14 @@ void WebContents::OnDidAddMessageToConsole(
     int32_t line_no,
     const std::u16string& source_id,
     const std::optional<std::u16string>& untrusted_stack_trace) {
+  // Messages taken by the session's sink skip JS unless asked otherwise.
+  if (ConsoleLogSink* sink = GetBrowserContext()->console_log_sink();
+      sink && sink->Matches(level, source_id)) {
+    sink->Add(ID(), level, message, line_no, source_id);
+    if (!sink->emit_events())
+      return;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
 
@@ -1969,6 +2031,7 @@ bool WebContents::EmitNavigationEvent(
 void WebContents::OnFirstNonEmptyLayout(
     content::RenderFrameHost* render_frame_host) {
   if (render_frame_host == web_contents()->GetPrimaryMainFrame()) {
+    startup_timeline::Mark("firstPaint");
     Emit("ready-to-show");
   }
 }
@@ -2948,7 +3011,26 @@ void OnGetDeviceNameToUse(base::WeakPtr<content::WebContents> web_contents,
                                std::move(print_callback));
 }
 
+void OnPDFWritten(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                  const base::FilePath& file_path,
+                  bool success) {
+  if (!success) {
+    promise.RejectWithErrorMessage("Failed to write PDF to " +
+                                   file_path.AsUTF8Unsafe());
+    return;
+  }
+
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(
+      v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+
+  promise.Resolve(node::Buffer::New(isolate, 0).ToLocalChecked());
+}
+
 void OnPDFCreated(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                  const base::FilePath& file_path,
                   print_to_pdf::PdfPrintResult print_result,
                   scoped_refptr<base::RefCountedMemory> data) {
   if (print_result != print_to_pdf::PdfPrintResult::kPrintSuccess) {
@@ -2958,6 +3040,24 @@ void OnPDFCreated(gin_helper::Promise<v8::Local<v8::Value>> promise,
     return;
   }
 
+  if (!file_path.empty()) {
+    // Write the document from the thread pool instead of copying it into the
+    // V8 heap, so that large PDFs don't go through the main thread at all.
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(
+            [](const base::FilePath& file_path,
+               scoped_refptr<base::RefCountedMemory> data) {
+              return base::WriteFile(
+                  file_path,
+                  std::string_view(reinterpret_cast<const char*>(data->front()),
+                                   data->size()));
+            },
+            file_path, std::move(data)),
+        base::BindOnce(&OnPDFWritten, std::move(promise), file_path));
+    return;
+  }
+
   v8::Isolate* isolate = promise.isolate();
   gin_helper::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -3163,6 +3263,9 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
   auto generate_tagged_pdf = settings.GetDict().FindBool("generateTaggedPDF");
   auto generate_document_outline =
       settings.GetDict().FindBool("generateDocumentOutline");
+  base::FilePath file_path;
+  if (const std::string* path = settings.GetDict().FindString("filePath"))
+    file_path = base::FilePath::FromUTF8Unsafe(*path);
 
   content::RenderFrameHost* rfh = GetRenderFrameHostToUse(web_contents());
   absl::variant<printing::mojom::PrintPagesParamsPtr, std::string>
@@ -3190,8 +3293,9 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
       absl::get<printing::mojom::PrintPagesParamsPtr>(print_pages_params));
   params->params->document_cookie = unique_id.value_or(0);
 
-  manager->PrintToPdf(rfh, page_ranges, std::move(params),
-                      base::BindOnce(&OnPDFCreated, std::move(promise)));
+  manager->PrintToPdf(
+      rfh, page_ranges, std::move(params),
+      base::BindOnce(&OnPDFCreated, std::move(promise), file_path));
 
   return handle;
 }
@@ -3860,59 +3964,151 @@ v8::Local<v8::Promise> WebContents::GetProcessMemoryInfo(v8::Isolate* isolate) {
 
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
     v8::Isolate* isolate,
-    const base::FilePath& file_path) {
+    const base::FilePath& file_path,
+    std::optional<gin_helper::Dictionary> options) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  ScopedAllowBlockingForElectron allow_blocking;
-  uint32_t flags = base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE;
-  // The snapshot file is passed to an untrusted process.
-  flags = base::File::AddFlagsForPassingToUntrustedProcess(flags);
-  base::File file(file_path, flags);
-  if (!file.IsValid()) {
-    promise.RejectWithErrorMessage(
-        "Failed to take heap snapshot with invalid file path " +
+  bool compress = false;
+  bool pipe = false;
+  if (options) {
+    std::string compression;
+    if (options->Get("compression", &compression) && compression != "none") {
+      if (compression != "gzip") {
+        promise.RejectWithErrorMessage("Unsupported compression " +
+                                       compression);
+        return handle;
+      }
+      compress = true;
+    }
+    options->Get("pipe", &pipe);
+  }
+
+  // This dance with `base::Owned` is to ensure that the interface stays alive
+  // until the callback is called. Otherwise it would be closed at the end of
+  // this function.
+  auto electron_renderer =
+      BindMainFrameRenderer(web_contents(), promise, "take heap snapshot");
+  if (!electron_renderer)
+    return handle;
+  OpenHeapProfileFile(
+      file_path, pipe,
+      base::BindOnce(
+          [](std::unique_ptr<mojo::Remote<mojom::ElectronRenderer>>
+                 electron_renderer,
+             gin_helper::Promise<void> promise, const base::FilePath& file_path,
+             bool compress, base::File file) {
+            if (!file.IsValid()) {
+              promise.RejectWithErrorMessage(
+                  "Failed to take heap snapshot with invalid file path " +
 #if BUILDFLAG(IS_WIN)
-        base::WideToUTF8(file_path.value()));
+                  base::WideToUTF8(file_path.value()));
 #else
-        file_path.value());
+                  file_path.value());
 #endif
-    return handle;
-  }
+              return;
+            }
+            auto* raw_ptr = electron_renderer.get();
+            (*raw_ptr)->TakeHeapSnapshot(
+                mojo::WrapPlatformFile(
+                    base::ScopedPlatformFile(file.TakePlatformFile())),
+                compress,
+                base::BindOnce(
+                    [](mojo::Remote<mojom::ElectronRenderer>* ep,
+                       gin_helper::Promise<void> promise, bool success) {
+                      if (success) {
+                        promise.Resolve();
+                      } else {
+                        promise.RejectWithErrorMessage(
+                            "Failed to take heap snapshot");
+                      }
+                    },
+                    base::Owned(std::move(electron_renderer)),
+                    std::move(promise)));
+          },
+          std::move(electron_renderer), std::move(promise), file_path,
+          compress));
+  return handle;
+}
 
-  auto* frame_host = web_contents()->GetPrimaryMainFrame();
-  if (!frame_host) {
-    promise.RejectWithErrorMessage(
-        "Failed to take heap snapshot with invalid webContents main frame");
-    return handle;
-  }
+v8::Local<v8::Promise> WebContents::StartHeapSampling(
+    v8::Isolate* isolate,
+    std::optional<gin_helper::Dictionary> options) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  if (!frame_host->IsRenderFrameLive()) {
+  // Same defaults as v8::HeapProfiler::StartSamplingHeapProfiler().
+  double sampling_interval = 512 * 1024;
+  int32_t stack_depth = 16;
+  if (options) {
+    options->Get("samplingInterval", &sampling_interval);
+    options->Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval < 1 || stack_depth < 1) {
     promise.RejectWithErrorMessage(
-        "Failed to take heap snapshot with nonexistent render frame");
+        "samplingInterval and stackDepth must be positive");
     return handle;
   }
 
-  // This dance with `base::Owned` is to ensure that the interface stays alive
-  // until the callback is called. Otherwise it would be closed at the end of
-  // this function.
   auto electron_renderer =
-      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
-  frame_host->GetRemoteInterfaces()->GetInterface(
-      electron_renderer->BindNewPipeAndPassReceiver());
+      BindMainFrameRenderer(web_contents(), promise, "start heap sampling");
+  if (!electron_renderer)
+    return handle;
   auto* raw_ptr = electron_renderer.get();
-  (*raw_ptr)->TakeHeapSnapshot(
-      mojo::WrapPlatformFile(base::ScopedPlatformFile(file.TakePlatformFile())),
+  (*raw_ptr)->StartSamplingHeapProfiler(
+      static_cast<uint64_t>(sampling_interval), stack_depth,
       base::BindOnce(
           [](mojo::Remote<mojom::ElectronRenderer>* ep,
-             gin_helper::Promise<void> promise, bool success) {
-            if (success) {
-              promise.Resolve();
-            } else {
-              promise.RejectWithErrorMessage("Failed to take heap snapshot");
+             gin_helper::Promise<void> promise) { promise.Resolve(); },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopHeapSampling(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto electron_renderer =
+      BindMainFrameRenderer(web_contents(), promise, "stop heap sampling");
+  if (!electron_renderer)
+    return handle;
+  OpenHeapProfileFile(
+      file_path, false,
+      base::BindOnce(
+          [](std::unique_ptr<mojo::Remote<mojom::ElectronRenderer>>
+                 electron_renderer,
+             gin_helper::Promise<void> promise, const base::FilePath& file_path,
+             base::File file) {
+            if (!file.IsValid()) {
+              promise.RejectWithErrorMessage(
+                  "Failed to stop heap sampling with invalid file path " +
+#if BUILDFLAG(IS_WIN)
+                  base::WideToUTF8(file_path.value()));
+#else
+                  file_path.value());
+#endif
+              return;
             }
+            auto* raw_ptr = electron_renderer.get();
+            (*raw_ptr)->StopSamplingHeapProfiler(
+                mojo::WrapPlatformFile(
+                    base::ScopedPlatformFile(file.TakePlatformFile())),
+                base::BindOnce(
+                    [](mojo::Remote<mojom::ElectronRenderer>* ep,
+                       gin_helper::Promise<void> promise, bool success) {
+                      if (success) {
+                        promise.Resolve();
+                      } else {
+                        promise.RejectWithErrorMessage(
+                            "Failed to stop heap sampling, was it started?");
+                      }
+                    },
+                    base::Owned(std::move(electron_renderer)),
+                    std::move(promise)));
           },
-          base::Owned(std::move(electron_renderer)), std::move(promise)));
+          std::move(electron_renderer), std::move(promise), file_path));
   return handle;
 }
 
@@ -4318,14 +4514,8 @@ void WebContents::UpdateHtmlApiFullscreen(bool fullscreen) {
 // static
 void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                                      v8::Local<v8::ObjectTemplate> templ) {
-  gin::InvokerOptions options;
-  options.holder_is_first_argument = true;
-  options.holder_type = GetClassName();
-  templ->Set(
-      gin::StringToSymbol(isolate, "isDestroyed"),
-      gin::CreateFunctionTemplate(
-          isolate, base::BindRepeating(&gin_helper::Destroyable::IsDestroyed),
-          options));
+  templ->Set(gin::StringToSymbol(isolate, "isDestroyed"),
+             gin_helper::Destroyable::GetIsDestroyedTemplate(isolate));
   // We use gin_helper::ObjectTemplateBuilder instead of
   // gin::ObjectTemplateBuilder here to handle the fact that WebContents is
   // destroyable.
@@ -4336,7 +4526,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::GetBackgroundThrottling)
       .SetMethod("setBackgroundThrottling",
                  &WebContents::SetBackgroundThrottling)
-      .SetMethod("getProcessId", &WebContents::GetProcessID)
+      .SetFastMethod<&WebContents::GetProcessID>("getProcessId")
       .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
       .SetMethod("equal", &WebContents::Equal)
       .SetMethod("_loadURL", &WebContents::LoadURL)
@@ -4345,9 +4535,9 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("downloadURL", &WebContents::DownloadURL)
       .SetMethod("getURL", &WebContents::GetURL)
       .SetMethod("getTitle", &WebContents::GetTitle)
-      .SetMethod("isLoading", &WebContents::IsLoading)
-      .SetMethod("isLoadingMainFrame", &WebContents::IsLoadingMainFrame)
-      .SetMethod("isWaitingForResponse", &WebContents::IsWaitingForResponse)
+      .SetFastMethod<&WebContents::IsLoading>("isLoading")
+      .SetFastMethod<&WebContents::IsLoadingMainFrame>("isLoadingMainFrame")
+      .SetFastMethod<&WebContents::IsWaitingForResponse>("isWaitingForResponse")
       .SetMethod("stop", &WebContents::Stop)
       .SetMethod("_canGoBack", &WebContents::CanGoBack)
       .SetMethod("_goBack", &WebContents::GoBack)
@@ -4366,7 +4556,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("_getHistory", &WebContents::GetHistory)
       .SetMethod("_clearHistory", &WebContents::ClearHistory)
       .SetMethod("_restoreHistory", &WebContents::RestoreHistory)
-      .SetMethod("isCrashed", &WebContents::IsCrashed)
+      .SetFastMethod<&WebContents::IsCrashed>("isCrashed")
       .SetMethod("forcefullyCrashRenderer",
                  &WebContents::ForcefullyCrashRenderer)
       .SetMethod("setUserAgent", &WebContents::SetUserAgent)
@@ -4384,7 +4574,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("inspectElement", &WebContents::InspectElement)
       .SetMethod("setIgnoreMenuShortcuts", &WebContents::SetIgnoreMenuShortcuts)
       .SetMethod("setAudioMuted", &WebContents::SetAudioMuted)
-      .SetMethod("isAudioMuted", &WebContents::IsAudioMuted)
+      .SetFastMethod<&WebContents::IsAudioMuted>("isAudioMuted")
       .SetMethod("isCurrentlyAudible", &WebContents::IsCurrentlyAudible)
       .SetMethod("undo", &WebContents::Undo)
       .SetMethod("redo", &WebContents::Redo)
@@ -4405,7 +4595,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("findInPage", &WebContents::FindInPage)
       .SetMethod("stopFindInPage", &WebContents::StopFindInPage)
       .SetMethod("focus", &WebContents::Focus)
-      .SetMethod("isFocused", &WebContents::IsFocused)
+      .SetFastMethod<&WebContents::IsFocused>("isFocused")
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
@@ -4420,9 +4610,9 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
-      .SetMethod("getZoomLevel", &WebContents::GetZoomLevel)
+      .SetFastMethod<&WebContents::GetZoomLevel>("getZoomLevel")
       .SetMethod("setZoomFactor", &WebContents::SetZoomFactor)
-      .SetMethod("getZoomFactor", &WebContents::GetZoomFactor)
+      .SetFastMethod<&WebContents::GetZoomFactor>("getZoomFactor")
       .SetMethod("getType", &WebContents::type)
       .SetMethod("_getPreloadScript", &WebContents::GetPreloadScript)
       .SetMethod("getLastWebPreferences", &WebContents::GetLastWebPreferences)
@@ -4456,6 +4646,8 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("getWebRTCUDPPortRange", &WebContents::GetWebRTCUDPPortRange)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("startHeapSampling", &WebContents::StartHeapSampling)
+      .SetMethod("stopHeapSampling", &WebContents::StopHeapSampling)
       .SetMethod("setImageAnimationPolicy",
                  &WebContents::SetImageAnimationPolicy)
       .SetMethod("_getProcessMemoryInfo", &WebContents::GetProcessMemoryInfo)
@@ -358,7 +358,14 @@ class WebContents final : public ExclusiveAccessContext,
   // Notifies the web page that there is user interaction.
   void NotifyUserActivation();
 
-  v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
+  v8::Local<v8::Promise> TakeHeapSnapshot(
+      v8::Isolate* isolate,
+      const base::FilePath& file_path,
+      std::optional<gin_helper::Dictionary> options);
+  v8::Local<v8::Promise> StartHeapSampling(
+      v8::Isolate* isolate,
+      std::optional<gin_helper::Dictionary> options);
+  v8::Local<v8::Promise> StopHeapSampling(v8::Isolate* isolate,
                                           const base::FilePath& file_path);
   v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
 
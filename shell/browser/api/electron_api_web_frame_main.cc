@@ -4,14 +4,18 @@
 
 #include "shell/browser/api/electron_api_web_frame_main.h"
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/containers/map_util.h"
 #include "base/feature_list.h"
 #include "base/logging.h"
+#include "base/memory/raw_ptr.h"
 #include "base/no_destructor.h"
 #include "content/browser/renderer_host/render_frame_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_process_host_impl.h"  // nogncheck
@@ -20,6 +24,7 @@
 #include "content/public/common/isolated_world_ids.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
@@ -117,6 +122,55 @@ FrameTokenMap& GetFrameTokenMap() {
   return *instance;
 }
 
+// Reads the optional |userGesture| argument of the executeJavaScript methods.
+// Throws and returns false if it is not a boolean.
+bool GetUserGestureArg(gin::Arguments* args, bool* user_gesture) {
+  *user_gesture = false;
+  if (args->PeekNext().IsEmpty())
+    return true;
+  if (!args->PeekNext()->IsBoolean()) {
+    args->ThrowTypeError("userGesture must be a boolean");
+    return false;
+  }
+  return args->GetNext(user_gesture);
+}
+
+// A frame that executeJavaScriptInSubtree() runs the script in. Frames may
+// go away before replying, so their ids are kept instead of the frame.
+struct ScriptFrame {
+  // The position of the frame in |framesInSubtree|.
+  size_t index;
+  int process_id;
+  int routing_id;
+};
+
+// The frames of one renderer process.
+struct ProcessScriptFrames {
+  raw_ptr<content::RenderProcessHost> process;
+  // The frame whose ElectronRenderer interface receives the request.
+  raw_ptr<content::RenderFrameHost> receiver;
+  std::vector<blink::LocalFrameToken> tokens;
+  std::vector<ScriptFrame> frames;
+};
+
+using IndexedScriptResult = std::pair<size_t, base::Value::Dict>;
+
+IndexedScriptResult MakeFrameScriptResult(const ScriptFrame& frame,
+                                          bool success,
+                                          base::Value value) {
+  base::Value::Dict result;
+  result.Set("processId", frame.process_id);
+  result.Set("routingId", frame.routing_id);
+  if (success) {
+    result.Set("status", "fulfilled");
+    result.Set("value", std::move(value));
+  } else {
+    result.Set("status", "rejected");
+    result.Set("reason", std::move(value));
+  }
+  return {frame.index, std::move(result)};
+}
+
 }  // namespace
 
 // static
@@ -220,16 +274,8 @@ v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScript(
 
   // Optional userGesture parameter
   bool user_gesture;
-  if (!args->PeekNext().IsEmpty()) {
-    if (args->PeekNext()->IsBoolean()) {
-      args->GetNext(&user_gesture);
-    } else {
-      args->ThrowTypeError("userGesture must be a boolean");
-      return handle;
-    }
-  } else {
-    user_gesture = false;
-  }
+  if (!GetUserGestureArg(args, &user_gesture))
+    return handle;
 
   if (render_frame_disposed_) {
     promise.RejectWithErrorMessage(
@@ -259,6 +305,98 @@ v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScript(
   return handle;
 }
 
+v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScriptInSubtree(
+    gin::Arguments* args,
+    const std::u16string& code) {
+  gin_helper::Promise<base::Value::List> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  bool user_gesture;
+  if (!GetUserGestureArg(args, &user_gesture))
+    return handle;
+
+  if (render_frame_disposed_) {
+    promise.RejectWithErrorMessage(
+        "Render frame was disposed before WebFrameMain could be accessed");
+    return handle;
+  }
+
+  // Frames are grouped by renderer process, so that each process gets a
+  // single request for all of its frames. Frames whose renderer isn't live
+  // are reported as rejected to keep the order of |framesInSubtree|.
+  std::vector<IndexedScriptResult> not_live_results;
+  std::vector<ProcessScriptFrames> frames_by_process;
+  size_t index = 0;
+  render_frame_host()->ForEachRenderFrameHost(
+      [&](content::RenderFrameHost* rfh) {
+        const ScriptFrame frame{index++,
+                                rfh->GetProcess()->GetID().GetUnsafeValue(),
+                                rfh->GetRoutingID()};
+        if (!rfh->IsRenderFrameLive()) {
+          not_live_results.push_back(MakeFrameScriptResult(
+              frame, false, base::Value("Render frame is not live")));
+          return;
+        }
+        auto iter = std::ranges::find(frames_by_process, rfh->GetProcess(),
+                                      &ProcessScriptFrames::process);
+        if (iter == frames_by_process.end()) {
+          frames_by_process.push_back({rfh->GetProcess(), rfh});
+          iter = std::prev(frames_by_process.end());
+        }
+        iter->tokens.push_back(rfh->GetFrameToken());
+        iter->frames.push_back(frame);
+      });
+
+  auto on_all_done = base::BarrierCallback<std::vector<IndexedScriptResult>>(
+      frames_by_process.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<base::Value::List> promise,
+             std::vector<IndexedScriptResult> results,
+             std::vector<std::vector<IndexedScriptResult>> process_results) {
+            for (auto& process_result : process_results)
+              std::ranges::move(process_result, std::back_inserter(results));
+            std::ranges::sort(results, {}, &IndexedScriptResult::first);
+            base::Value::List list;
+            list.reserve(results.size());
+            for (auto& [frame_index, result] : results)
+              list.Append(std::move(result));
+            promise.Resolve(list);
+          },
+          std::move(promise), std::move(not_live_results)));
+
+  for (auto& process_frames : frames_by_process) {
+    auto on_results = base::BindOnce(
+        [](std::vector<ScriptFrame> frames,
+           base::OnceCallback<void(std::vector<IndexedScriptResult>)> done,
+           std::vector<mojom::ScriptResultPtr> script_results) {
+          std::vector<IndexedScriptResult> results;
+          for (size_t i = 0; i < frames.size(); ++i) {
+            // Results are missing when the renderer went away.
+            const bool has_result = i < script_results.size();
+            results.push_back(MakeFrameScriptResult(
+                frames[i], has_result && script_results[i]->success,
+                has_result ? std::move(script_results[i]->value)
+                           : base::Value("Render frame was disposed before "
+                                         "the script finished")));
+          }
+          std::move(done).Run(std::move(results));
+        },
+        std::move(process_frames.frames),
+        base::OnceCallback<void(std::vector<IndexedScriptResult>)>(
+            on_all_done));
+    // Any frame of the process can run the script in the others.
+    WebFrameMain::From(args->isolate(), process_frames.receiver)
+        ->GetRendererApi()
+        ->ExecuteJavaScriptInFrames(code, user_gesture,
+                                    std::move(process_frames.tokens),
+                                    mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                                        std::move(on_results),
+                                        std::vector<mojom::ScriptResultPtr>()));
+  }
+
+  return handle;
+}
+
 bool WebFrameMain::Reload() {
   if (!CheckRenderFrame())
     return false;
@@ -286,6 +424,31 @@ void WebFrameMain::Send(v8::Isolate* isolate,
   GetRendererApi()->Message(internal, channel, std::move(message));
 }
 
+// static
+int WebFrameMain::Broadcast(v8::Isolate* isolate,
+                            bool internal,
+                            const std::string& channel,
+                            v8::Local<v8::Value> args,
+                            const std::vector<WebFrameMain*>& frames) {
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate, args, &message)) {
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Failed to serialize arguments")));
+    return 0;
+  }
+
+  int sent = 0;
+  for (WebFrameMain* frame : frames) {
+    if (!frame || !frame->HasRenderFrame())
+      continue;
+    // The shallow clones point at |message|'s encoded bytes instead of
+    // copying them.
+    frame->GetRendererApi()->Message(internal, channel, message.ShallowClone());
+    ++sent;
+  }
+  return sent;
+}
+
 const mojo::Remote<mojom::ElectronRenderer>& WebFrameMain::GetRendererApi() {
   MaybeSetupMojoConnection();
   return renderer_api_;
@@ -579,6 +742,8 @@ void WebFrameMain::FillObjectTemplate(v8::Isolate* isolate,
                                       v8::Local<v8::ObjectTemplate> templ) {
   gin_helper::ObjectTemplateBuilder(isolate, templ)
       .SetMethod("executeJavaScript", &WebFrameMain::ExecuteJavaScript)
+      .SetMethod("executeJavaScriptInSubtree",
+                 &WebFrameMain::ExecuteJavaScriptInSubtree)
       .SetMethod("collectJavaScriptCallStack",
                  &WebFrameMain::CollectDocumentJSCallStack)
       .SetMethod("reload", &WebFrameMain::Reload)
@@ -667,6 +832,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("fromId", &FromID);
   dict.SetMethod("_fromIdIfExists", &FromIdIfExists);
   dict.SetMethod("_fromFtnIdIfExists", &FromFtnIdIfExists);
+  dict.SetMethod("_broadcast", &WebFrameMain::Broadcast);
 }
 
 }  // namespace
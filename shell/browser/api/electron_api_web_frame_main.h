@@ -65,6 +65,14 @@ class WebFrameMain final : public gin::Wrappable<WebFrameMain>,
 
   // gin_helper::Constructible
   static void FillObjectTemplate(v8::Isolate*, v8::Local<v8::ObjectTemplate>);
+
+  // Serializes |args| once and sends the resulting message to every frame in
+  // |frames| that is still alive. Returns the number of frames messaged.
+  static int Broadcast(v8::Isolate* isolate,
+                       bool internal,
+                       const std::string& channel,
+                       v8::Local<v8::Value> args,
+                       const std::vector<WebFrameMain*>& frames);
   static const char* GetClassName() { return "WebFrameMain"; }
 
   // gin::Wrappable
@@ -110,6 +118,9 @@ class WebFrameMain final : public gin::Wrappable<WebFrameMain>,
 
   v8::Local<v8::Promise> ExecuteJavaScript(gin::Arguments* args,
                                            const std::u16string& code);
+  v8::Local<v8::Promise> ExecuteJavaScriptInSubtree(
+      gin::Arguments* args,
+      const std::u16string& code);
   bool Reload();
   bool IsDestroyed() const;
   void Send(v8::Isolate* isolate,
@@ -4,13 +4,18 @@
 
 #include "shell/browser/api/electron_api_web_request.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "base/containers/adapters.h"
 #include "base/containers/fixed_flat_map.h"
 #include "base/memory/raw_ptr.h"
+#include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/values.h"
 #include "extensions/browser/api/web_request/web_request_info.h"
@@ -20,6 +25,8 @@
 #include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
@@ -32,6 +39,7 @@
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/function_template.h"
 #include "shell/common/node_util.h"
 
 static constexpr auto ResourceTypes =
@@ -51,17 +59,25 @@ static constexpr auto ResourceTypes =
         {"xhr", extensions::WebRequestResourceType::XHR},
     });
 
+namespace {
+
+std::string_view ResourceTypeToString(extensions::WebRequestResourceType type) {
+  for (const auto& [name, val] : ResourceTypes)
+    if (type == val)
+      return name;
+
+  return "other";
+}
+
+}  // namespace
+
 namespace gin {
 
 template <>
 struct Converter<extensions::WebRequestResourceType> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
                                    extensions::WebRequestResourceType type) {
-    for (const auto& [name, val] : ResourceTypes)
-      if (type == val)
-        return StringToV8(isolate, name);
-
-    return StringToV8(isolate, "other");
+    return StringToV8(isolate, ResourceTypeToString(type));
   }
 };
 
@@ -73,6 +89,11 @@ namespace {
 
 const char kUserDataKey[] = "WebRequest";
 
+// Observations are delivered early once this many have been queued.
+constexpr size_t kMaxObservationBatchSize = 1000;
+
+constexpr base::TimeDelta kDefaultObserverInterval = base::Milliseconds(100);
+
 // BrowserContext <=> WebRequest relationship.
 struct UserData : public base::SupportsUserData::Data {
   explicit UserData(WebRequest* data) : data(data) {}
@@ -86,23 +107,36 @@ extensions::WebRequestResourceType ParseResourceType(std::string_view value) {
   return extensions::WebRequestResourceType::OTHER;
 }
 
-// Convert HttpResponseHeaders to V8.
-//
-// Note that while we already have converters for HttpResponseHeaders, we can
-// not use it because it lowercases the header keys, while the webRequest has
-// to pass the original keys.
-v8::Local<v8::Value> HttpResponseHeadersToV8(
-    net::HttpResponseHeaders* headers) {
-  base::Value::Dict response_headers;
-  if (headers) {
-    size_t iter = 0;
-    std::string key;
-    std::string value;
-    while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-      response_headers.EnsureList(key)->Append(value);
-    }
-  }
-  return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
+// Unlike the HttpResponseHeaders converter, keeps the original case of the
+// header names, as webRequest has always passed them.
+v8::Local<v8::Value> ResponseHeadersToV8(
+    scoped_refptr<net::HttpResponseHeaders> headers,
+    v8::Isolate* isolate) {
+  return HttpResponseHeadersToV8(isolate, headers.get(),
+                                 /*lowercase_names=*/false);
+}
+
+v8::Local<v8::Value> RequestBodyToV8(
+    scoped_refptr<network::ResourceRequestBody> body,
+    v8::Isolate* isolate) {
+  return gin::ConvertToV8(isolate, *body);
+}
+
+// Defines |key| on |details| as a property that is only converted from |arg|
+// when the listener first reads it. Most listeners never look at the upload
+// data or the response headers.
+template <typename T>
+void SetLazy(gin_helper::Dictionary* details,
+             std::string_view key,
+             v8::Local<v8::Value> (*convert)(scoped_refptr<T>, v8::Isolate*),
+             scoped_refptr<T> arg) {
+  v8::Isolate* isolate = details->isolate();
+  auto [getter, data] = gin_helper::CreateDataPropertyCallback(
+      isolate, base::BindRepeating(convert, std::move(arg)));
+  details->GetHandle()
+      ->SetLazyDataProperty(isolate->GetCurrentContext(),
+                            gin::StringToV8(isolate, key), getter, data)
+      .Check();
 }
 
 // Overloaded by multiple types to fill the |details| object.
@@ -120,8 +154,8 @@ void ToDictionary(gin_helper::Dictionary* details,
     details->Set("fromCache", info->response_from_cache);
     details->Set("statusLine", info->response_headers->GetStatusLine());
     details->Set("statusCode", info->response_headers->response_code());
-    details->Set("responseHeaders",
-                 HttpResponseHeadersToV8(info->response_headers.get()));
+    SetLazy(details, "responseHeaders", &ResponseHeadersToV8,
+            info->response_headers);
   }
 
   auto* render_frame_host = content::RenderFrameHost::FromID(
@@ -142,7 +176,7 @@ void ToDictionary(gin_helper::Dictionary* details,
                   const network::ResourceRequest& request) {
   details->Set("referrer", request.referrer);
   if (request.request_body)
-    details->Set("uploadData", *request.request_body);
+    SetLazy(details, "uploadData", &RequestBodyToV8, request.request_body);
 }
 
 void ToDictionary(gin_helper::Dictionary* details,
@@ -296,11 +330,87 @@ struct WebRequest::BlockedRequest {
   std::string status_line;
   // Only used for onBeforeRequest.
   raw_ptr<GURL> new_url = nullptr;
+  // Only used when several listeners matched the request.
+  size_t pending_responses = 0;
+  std::vector<v8::Global<v8::Value>> responses;
 };
 
+namespace {
+
+// Inserts |info| after all the listeners whose priority is at least as high,
+// so listeners with the same priority run in the order they were added.
+template <typename Info>
+void InsertListener(std::vector<Info>* listeners, Info info) {
+  const auto pos =
+      std::ranges::find_if(*listeners, [&info](const Info& listener) {
+        return listener.priority < info.priority;
+      });
+  listeners->insert(pos, std::move(info));
+}
+
+// Lowercased header name -> the name as spelled by its last writer, and the
+// values of the header.
+using HeaderMap =
+    std::map<std::string, std::pair<std::string, std::vector<std::string>>>;
+
+HeaderMap ToHeaderMap(const net::HttpRequestHeaders& headers) {
+  HeaderMap map;
+  for (net::HttpRequestHeaders::Iterator it(headers); it.GetNext();)
+    map[base::ToLowerASCII(it.name())] = {it.name(), {it.value()}};
+  return map;
+}
+
+HeaderMap ToHeaderMap(const net::HttpResponseHeaders& headers) {
+  HeaderMap map;
+  size_t iter = 0;
+  std::string name;
+  std::string value;
+  while (headers.EnumerateHeaderLines(&iter, &name, &value)) {
+    auto& entry = map[base::ToLowerASCII(name)];
+    entry.first = name;
+    entry.second.push_back(value);
+  }
+  return map;
+}
+
+// Applies to |merged| the headers that |changed| adds, modifies or removes
+// compared to |original|, leaving the other headers of |merged| alone.
+void ApplyHeaderChanges(const HeaderMap& original,
+                        const HeaderMap& changed,
+                        HeaderMap* merged) {
+  for (const auto& [key, entry] : original) {
+    if (!changed.contains(key))
+      merged->erase(key);
+  }
+  for (const auto& [key, entry] : changed) {
+    const auto iter = original.find(key);
+    if (iter == original.end() || iter->second.second != entry.second)
+      (*merged)[key] = entry;
+  }
+}
+
+v8::Local<v8::Value> HeaderMapToV8(v8::Isolate* isolate,
+                                   const HeaderMap& headers) {
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  for (const auto& [key, entry] : headers) {
+    const auto& [name, values] = entry;
+    if (values.size() == 1)
+      dict.Set(name, values.front());
+    else
+      dict.Set(name, values);
+  }
+  return dict.GetHandle();
+}
+
+}  // namespace
+
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(RequestFilter filter_,
                                                    SimpleListener listener_)
     : filter(std::move(filter_)), listener(listener_) {}
+WebRequest::SimpleListenerInfo::SimpleListenerInfo(
+    SimpleListenerInfo&&) = default;
+WebRequest::SimpleListenerInfo& WebRequest::SimpleListenerInfo::operator=(
+    SimpleListenerInfo&&) = default;
 WebRequest::SimpleListenerInfo::SimpleListenerInfo() = default;
 WebRequest::SimpleListenerInfo::~SimpleListenerInfo() = default;
 
@@ -308,6 +418,10 @@ WebRequest::ResponseListenerInfo::ResponseListenerInfo(
     RequestFilter filter_,
     ResponseListener listener_)
     : filter(std::move(filter_)), listener(listener_) {}
+WebRequest::ResponseListenerInfo::ResponseListenerInfo(
+    ResponseListenerInfo&&) = default;
+WebRequest::ResponseListenerInfo& WebRequest::ResponseListenerInfo::operator=(
+    ResponseListenerInfo&&) = default;
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
@@ -343,7 +457,10 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<SimpleEvent::kOnErrorOccurred>)
       .SetMethod("onCompleted",
-                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>);
+                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>)
+      .SetMethod("addListener", &WebRequest::AddListener)
+      .SetMethod("removeListener", &WebRequest::RemoveListener)
+      .SetMethod("setObserver", &WebRequest::SetObserver);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -351,13 +468,15 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           !observer_);
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  Observe("onBeforeRequest", info);
   return HandleOnBeforeRequestResponseEvent(info, request, std::move(callback),
                                             new_url);
 }
@@ -367,29 +486,13 @@ int WebRequest::HandleOnBeforeRequestResponseEvent(
     const network::ResourceRequest& request,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  const auto iter = response_listeners_.find(ResponseEvent::kOnBeforeRequest);
-  if (iter == std::end(response_listeners_))
-    return net::OK;
-
-  const auto& info = iter->second;
-  if (!info.filter.MatchesRequest(request_info))
-    return net::OK;
-
   BlockedRequest blocked_request;
   blocked_request.callback = std::move(callback);
   blocked_request.new_url = new_url;
-  blocked_requests_[request_info->id] = std::move(blocked_request);
-
-  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-  v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
-  FillDetails(&details, request_info, request, *new_url);
-
-  ResponseCallback response =
-      base::BindOnce(&WebRequest::OnBeforeRequestListenerResult,
-                     base::Unretained(this), request_info->id);
-  info.listener.Run(gin::ConvertToV8(isolate, details), std::move(response));
-  return net::ERR_IO_PENDING;
+  return HandleResponseEvent(ResponseEvent::kOnBeforeRequest, request_info,
+                             std::move(blocked_request),
+                             &WebRequest::OnBeforeRequestListenerResult,
+                             request, *new_url);
 }
 
 void WebRequest::OnBeforeRequestListenerResult(uint64_t id,
@@ -423,6 +526,7 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  Observe("onBeforeSendHeaders", info);
   return HandleOnBeforeSendHeadersResponseEvent(info, request,
                                                 std::move(callback), headers);
 }
@@ -432,30 +536,13 @@ int WebRequest::HandleOnBeforeSendHeadersResponseEvent(
     const network::ResourceRequest& request,
     BeforeSendHeadersCallback callback,
     net::HttpRequestHeaders* headers) {
-  const auto iter =
-      response_listeners_.find(ResponseEvent::kOnBeforeSendHeaders);
-  if (iter == std::end(response_listeners_))
-    return net::OK;
-
-  const auto& info = iter->second;
-  if (!info.filter.MatchesRequest(request_info))
-    return net::OK;
-
   BlockedRequest blocked_request;
   blocked_request.before_send_headers_callback = std::move(callback);
   blocked_request.request_headers = headers;
-  blocked_requests_[request_info->id] = std::move(blocked_request);
-
-  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-  v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
-  FillDetails(&details, request_info, request, *headers);
-
-  ResponseCallback response =
-      base::BindOnce(&WebRequest::OnBeforeSendHeadersListenerResult,
-                     base::Unretained(this), request_info->id);
-  info.listener.Run(gin::ConvertToV8(isolate, details), std::move(response));
-  return net::ERR_IO_PENDING;
+  return HandleResponseEvent(ResponseEvent::kOnBeforeSendHeaders, request_info,
+                             std::move(blocked_request),
+                             &WebRequest::OnBeforeSendHeadersListenerResult,
+                             request, *headers);
 }
 
 void WebRequest::OnBeforeSendHeadersListenerResult(
@@ -513,6 +600,13 @@ int WebRequest::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  if (original_response_headers) {
+    base::Value::Dict details;
+    details.Set("statusCode", original_response_headers->response_code());
+    Observe("onHeadersReceived", info, std::move(details));
+  } else {
+    Observe("onHeadersReceived", info);
+  }
   return HandleOnHeadersReceivedResponseEvent(
       info, request, std::move(callback), original_response_headers,
       override_response_headers);
@@ -524,32 +618,17 @@ int WebRequest::HandleOnHeadersReceivedResponseEvent(
     net::CompletionOnceCallback callback,
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers) {
-  const auto iter = response_listeners_.find(ResponseEvent::kOnHeadersReceived);
-  if (iter == std::end(response_listeners_))
-    return net::OK;
-
-  const auto& info = iter->second;
-  if (!info.filter.MatchesRequest(request_info))
-    return net::OK;
-
   BlockedRequest blocked_request;
   blocked_request.callback = std::move(callback);
   blocked_request.override_response_headers = override_response_headers;
+  blocked_request.original_response_headers = original_response_headers;
   blocked_request.status_line = original_response_headers
                                     ? original_response_headers->GetStatusLine()
                                     : std::string();
-  blocked_requests_[request_info->id] = std::move(blocked_request);
-
-  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-  v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
-  FillDetails(&details, request_info, request);
-
-  ResponseCallback response =
-      base::BindOnce(&WebRequest::OnHeadersReceivedListenerResult,
-                     base::Unretained(this), request_info->id);
-  info.listener.Run(gin::ConvertToV8(isolate, details), std::move(response));
-  return net::ERR_IO_PENDING;
+  return HandleResponseEvent(ResponseEvent::kOnHeadersReceived, request_info,
+                             std::move(blocked_request),
+                             &WebRequest::OnHeadersReceivedListenerResult,
+                             request);
 }
 
 void WebRequest::OnHeadersReceivedListenerResult(
@@ -598,18 +677,23 @@ void WebRequest::OnHeadersReceivedListenerResult(
 void WebRequest::OnSendHeaders(extensions::WebRequestInfo* info,
                                const network::ResourceRequest& request,
                                const net::HttpRequestHeaders& headers) {
+  Observe("onSendHeaders", info);
   HandleSimpleEvent(SimpleEvent::kOnSendHeaders, info, request, headers);
 }
 
 void WebRequest::OnBeforeRedirect(extensions::WebRequestInfo* info,
                                   const network::ResourceRequest& request,
                                   const GURL& new_location) {
+  base::Value::Dict details;
+  details.Set("redirectURL", new_location.spec());
+  Observe("onBeforeRedirect", info, std::move(details));
   HandleSimpleEvent(SimpleEvent::kOnBeforeRedirect, info, request,
                     new_location);
 }
 
 void WebRequest::OnResponseStarted(extensions::WebRequestInfo* info,
                                    const network::ResourceRequest& request) {
+  Observe("onResponseStarted", info);
   HandleSimpleEvent(SimpleEvent::kOnResponseStarted, info, request);
 }
 
@@ -618,6 +702,9 @@ void WebRequest::OnErrorOccurred(extensions::WebRequestInfo* info,
                                  int net_error) {
   blocked_requests_.erase(info->id);
 
+  base::Value::Dict details;
+  details.Set("error", net::ErrorToString(net_error));
+  Observe("onErrorOccurred", info, std::move(details));
   HandleSimpleEvent(SimpleEvent::kOnErrorOccurred, info, request, net_error);
 }
 
@@ -626,6 +713,9 @@ void WebRequest::OnCompleted(extensions::WebRequestInfo* info,
                              int net_error) {
   blocked_requests_.erase(info->id);
 
+  base::Value::Dict details;
+  details.Set("error", net::ErrorToString(net_error));
+  Observe("onCompleted", info, std::move(details));
   HandleSimpleEvent(SimpleEvent::kOnCompleted, info, request, net_error);
 }
 
@@ -643,16 +733,45 @@ void WebRequest::SetResponseListener(gin::Arguments* args) {
   SetListener<ResponseListener>(event, &response_listeners_, args);
 }
 
-template <typename Listener, typename Listeners, typename Event>
-void WebRequest::SetListener(Event event,
-                             Listeners* listeners,
-                             gin::Arguments* args) {
-  v8::Local<v8::Value> arg;
+// static
+std::optional<WebRequest::SimpleEvent> WebRequest::ParseSimpleEvent(
+    std::string_view name) {
+  static constexpr auto kEvents =
+      base::MakeFixedFlatMap<std::string_view, SimpleEvent>({
+          {"onBeforeRedirect", SimpleEvent::kOnBeforeRedirect},
+          {"onCompleted", SimpleEvent::kOnCompleted},
+          {"onErrorOccurred", SimpleEvent::kOnErrorOccurred},
+          {"onResponseStarted", SimpleEvent::kOnResponseStarted},
+          {"onSendHeaders", SimpleEvent::kOnSendHeaders},
+      });
+  if (auto iter = kEvents.find(name); iter != kEvents.end())
+    return iter->second;
+  return std::nullopt;
+}
+
+// static
+std::optional<WebRequest::ResponseEvent> WebRequest::ParseResponseEvent(
+    std::string_view name) {
+  static constexpr auto kEvents =
+      base::MakeFixedFlatMap<std::string_view, ResponseEvent>({
+          {"onBeforeRequest", ResponseEvent::kOnBeforeRequest},
+          {"onBeforeSendHeaders", ResponseEvent::kOnBeforeSendHeaders},
+          {"onHeadersReceived", ResponseEvent::kOnHeadersReceived},
+      });
+  if (auto iter = kEvents.find(name); iter != kEvents.end())
+    return iter->second;
+  return std::nullopt;
+}
+
+// static
+bool WebRequest::ParseFilter(gin::Arguments* args,
+                             RequestFilter* filter,
+                             v8::Local<v8::Value>* next) {
+  v8::Local<v8::Value>& arg = *next;
 
   // { urls, excludeUrls, types }.
   std::set<std::string> filter_include_patterns, filter_exclude_patterns,
       filter_types;
-  RequestFilter filter;
 
   gin::Dictionary dict(args->isolate());
   if (args->GetNext(&arg) && !arg->IsFunction()) {
@@ -662,7 +781,7 @@ void WebRequest::SetListener(Event event,
     if (gin::ConvertFromV8(args->isolate(), arg, &dict)) {
       if (!dict.Get("urls", &filter_include_patterns)) {
         args->ThrowTypeError("Parameter 'filter' must have property 'urls'.");
-        return;
+        return false;
       }
 
       if (filter_include_patterns.empty()) {
@@ -685,19 +804,31 @@ void WebRequest::SetListener(Event event,
     dict.Set("urls", filter_include_patterns);
   }
 
-  filter.AddUrlPatterns(filter_include_patterns, &filter, args);
-  filter.AddUrlPatterns(filter_exclude_patterns, &filter, args, false);
+  filter->AddUrlPatterns(filter_include_patterns, filter, args);
+  filter->AddUrlPatterns(filter_exclude_patterns, filter, args, false);
 
   for (const std::string& filter_type : filter_types) {
     auto type = ParseResourceType(filter_type);
     if (type != extensions::WebRequestResourceType::OTHER) {
-      filter.AddType(type);
+      filter->AddType(type);
     } else {
       args->ThrowTypeError("Invalid type " + filter_type);
-      return;
+      return false;
     }
   }
 
+  return true;
+}
+
+template <typename Listener, typename Listeners, typename Event>
+void WebRequest::SetListener(Event event,
+                             Listeners* listeners,
+                             gin::Arguments* args) {
+  RequestFilter filter;
+  v8::Local<v8::Value> arg;
+  if (!ParseFilter(args, &filter, &arg))
+    return;
+
   // Function or null.
   Listener listener;
   if (arg.IsEmpty() ||
@@ -706,29 +837,326 @@ void WebRequest::SetListener(Event event,
     return;
   }
 
-  if (listener.is_null())
+  // The on<Event>() methods replace the previous listener they have set,
+  // leaving the ones added with addListener() alone.
+  auto& event_listeners = (*listeners)[event];
+  std::erase_if(event_listeners,
+                [](const auto& info) { return info.function.IsEmpty(); });
+  if (!listener.is_null())
+    InsertListener(&event_listeners, {std::move(filter), std::move(listener)});
+  if (event_listeners.empty())
     listeners->erase(event);
+}
+
+void WebRequest::AddListener(gin::Arguments* args) {
+  std::string name;
+  if (!args->GetNext(&name)) {
+    args->ThrowTypeError("Must pass an event name");
+    return;
+  }
+
+  if (auto event = ParseSimpleEvent(name))
+    AddListenerForEvent<SimpleListener>(*event, &simple_listeners_, args);
+  else if (auto response_event = ParseResponseEvent(name))
+    AddListenerForEvent<ResponseListener>(*response_event,
+                                          &response_listeners_, args);
   else
-    (*listeners)[event] = {std::move(filter), std::move(listener)};
+    args->ThrowTypeError("Invalid event name " + name);
+}
+
+template <typename Listener, typename Listeners, typename Event>
+void WebRequest::AddListenerForEvent(Event event,
+                                     Listeners* listeners,
+                                     gin::Arguments* args) {
+  RequestFilter filter;
+  v8::Local<v8::Value> arg;
+  if (!ParseFilter(args, &filter, &arg))
+    return;
+
+  Listener listener;
+  if (arg.IsEmpty() || !arg->IsFunction() ||
+      !gin::ConvertFromV8(args->isolate(), arg, &listener)) {
+    args->ThrowTypeError("Must pass a Function");
+    return;
+  }
+
+  // { priority }.
+  int priority = 0;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("priority", &priority);
+
+  // Adding the same function again updates its filter and priority.
+  auto& event_listeners = (*listeners)[event];
+  std::erase_if(event_listeners,
+                [&arg](const auto& info) { return info.function == arg; });
+
+  typename Listeners::mapped_type::value_type info(std::move(filter),
+                                                   std::move(listener));
+  info.priority = priority;
+  info.function.Reset(args->isolate(), arg);
+  InsertListener(&event_listeners, std::move(info));
+}
+
+void WebRequest::RemoveListener(gin::Arguments* args) {
+  std::string name;
+  v8::Local<v8::Function> function;
+  if (!args->GetNext(&name) || !args->GetNext(&function)) {
+    args->ThrowTypeError("Must pass an event name and a Function");
+    return;
+  }
+
+  auto remove = [&function](auto* listeners, auto event) {
+    const auto iter = listeners->find(event);
+    if (iter == std::end(*listeners))
+      return;
+    std::erase_if(iter->second, [&function](const auto& info) {
+      return info.function == function;
+    });
+    if (iter->second.empty())
+      listeners->erase(iter);
+  };
+
+  if (auto event = ParseSimpleEvent(name))
+    remove(&simple_listeners_, *event);
+  else if (auto response_event = ParseResponseEvent(name))
+    remove(&response_listeners_, *response_event);
+  else
+    args->ThrowTypeError("Invalid event name " + name);
+}
+
+void WebRequest::SetObserver(gin::Arguments* args) {
+  RequestFilter filter;
+  v8::Local<v8::Value> arg;
+  if (!ParseFilter(args, &filter, &arg))
+    return;
+
+  // Function or null.
+  SimpleListener listener;
+  if (arg.IsEmpty() ||
+      !(gin::ConvertFromV8(args->isolate(), arg, &listener) || arg->IsNull())) {
+    args->ThrowTypeError("Must pass null or a Function");
+    return;
+  }
+
+  // { interval }.
+  int64_t interval_ms = kDefaultObserverInterval.InMilliseconds();
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) && options.Get("interval", &interval_ms) &&
+      interval_ms < 0) {
+    args->ThrowTypeError("'interval' must not be negative");
+    return;
+  }
+
+  observer_timer_.Stop();
+  observations_.clear();
+  if (listener.is_null()) {
+    observer_.reset();
+  } else {
+    observer_.emplace(std::move(filter), std::move(listener));
+    observer_interval_ = base::Milliseconds(interval_ms);
+  }
+}
+
+void WebRequest::Observe(std::string_view event,
+                         extensions::WebRequestInfo* info,
+                         base::Value::Dict details) {
+  if (!observer_ || !observer_->filter.MatchesRequest(info))
+    return;
+
+  details.Set("event", event);
+  details.Set("id", static_cast<double>(info->id));
+  details.Set("url", info->url.spec());
+  details.Set("method", info->method);
+  details.Set("timestamp",
+              base::Time::Now().InSecondsFSinceUnixEpoch() * 1000);
+  details.Set("resourceType", ResourceTypeToString(info->web_request_type));
+  if (!info->response_ip.empty())
+    details.Set("ip", info->response_ip);
+  if (info->response_headers) {
+    details.Set("fromCache", info->response_from_cache);
+    details.Set("statusCode", info->response_headers->response_code());
+  }
+  auto* render_frame_host = content::RenderFrameHost::FromID(
+      info->render_process_id, info->frame_routing_id);
+  if (render_frame_host) {
+    auto* api_web_contents = WebContents::From(
+        content::WebContents::FromRenderFrameHost(render_frame_host));
+    if (api_web_contents)
+      details.Set("webContentsId", api_web_contents->ID());
+  }
+  observations_.Append(std::move(details));
+
+  // Deliver on a later task, so that the request never waits for JS.
+  if (observations_.size() >= kMaxObservationBatchSize) {
+    observer_timer_.Start(FROM_HERE, base::TimeDelta(), this,
+                          &WebRequest::FlushObservations);
+  } else if (!observer_timer_.IsRunning()) {
+    observer_timer_.Start(FROM_HERE, observer_interval_, this,
+                          &WebRequest::FlushObservations);
+  }
+}
+
+void WebRequest::FlushObservations() {
+  if (!observer_ || observations_.empty())
+    return;
+
+  base::Value::List batch = std::exchange(observations_, {});
+  // Copy the listener since it may replace the observer while running.
+  SimpleListener listener = observer_->listener;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  listener.Run(gin::ConvertToV8(isolate, batch));
 }
 
 template <typename... Args>
 void WebRequest::HandleSimpleEvent(SimpleEvent event,
                                    extensions::WebRequestInfo* request_info,
-                                   Args... args) {
+                                   const Args&... args) {
   const auto iter = simple_listeners_.find(event);
   if (iter == std::end(simple_listeners_))
     return;
 
-  const auto& info = iter->second;
-  if (!info.filter.MatchesRequest(request_info))
+  // Filters are matched before entering V8, and the matching listeners are
+  // copied since they may add or remove listeners while running.
+  std::vector<SimpleListener> matched;
+  for (const auto& info : iter->second) {
+    if (info.filter.MatchesRequest(request_info))
+      matched.push_back(info.listener);
+  }
+  if (matched.empty())
     return;
 
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
-  FillDetails(&details, request_info, args...);
-  info.listener.Run(gin::ConvertToV8(isolate, details));
+  for (const auto& listener : matched) {
+    gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
+    FillDetails(&details, request_info, args...);
+    listener.Run(gin::ConvertToV8(isolate, details));
+  }
+}
+
+template <typename... Args>
+int WebRequest::HandleResponseEvent(ResponseEvent event,
+                                    extensions::WebRequestInfo* request_info,
+                                    BlockedRequest blocked_request,
+                                    ListenerResultHandler on_result,
+                                    const Args&... args) {
+  const auto iter = response_listeners_.find(event);
+  if (iter == std::end(response_listeners_))
+    return net::OK;
+
+  std::vector<ResponseListener> matched;
+  for (const auto& info : iter->second) {
+    if (info.filter.MatchesRequest(request_info))
+      matched.push_back(info.listener);
+  }
+  if (matched.empty())
+    return net::OK;
+
+  const uint64_t id = request_info->id;
+  blocked_request.pending_responses = matched.size();
+  if (matched.size() > 1)
+    blocked_request.responses.resize(matched.size());
+  blocked_requests_[id] = std::move(blocked_request);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  for (size_t i = 0; i < matched.size(); ++i) {
+    // A listener has already cancelled the request.
+    if (!blocked_requests_.contains(id))
+      break;
+
+    gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
+    FillDetails(&details, request_info, args...);
+
+    ResponseCallback response;
+    if (matched.size() == 1) {
+      response = base::BindOnce(on_result, base::Unretained(this), id);
+    } else {
+      response = base::BindOnce(&WebRequest::OnPartialListenerResult,
+                                base::Unretained(this), id, i, on_result);
+    }
+    matched[i].Run(gin::ConvertToV8(isolate, details), std::move(response));
+  }
+  return net::ERR_IO_PENDING;
+}
+
+void WebRequest::OnPartialListenerResult(uint64_t id,
+                                         size_t index,
+                                         ListenerResultHandler on_result,
+                                         v8::Local<v8::Value> response) {
+  const auto iter = blocked_requests_.find(id);
+  if (iter == std::end(blocked_requests_))
+    return;
+
+  auto& request = iter->second;
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+
+  // A cancellation wins over everything else, so don't wait for the other
+  // listeners.
+  if (response->IsObject()) {
+    gin_helper::Dictionary dict(isolate, response.As<v8::Object>());
+    bool cancel = false;
+    if (dict.Get("cancel", &cancel) && cancel) {
+      (this->*on_result)(id, response);
+      return;
+    }
+  }
+
+  request.responses[index].Reset(isolate, response);
+  if (--request.pending_responses > 0)
+    return;
+
+  // Otherwise the header changes of every listener are applied on top of
+  // each other, from the lowest priority to the highest so that the latter
+  // win conflicts, as do their redirectURL and statusLine.
+  HeaderMap original_headers;
+  if (request.request_headers)
+    original_headers = ToHeaderMap(*request.request_headers);
+  else if (request.original_response_headers)
+    original_headers = ToHeaderMap(*request.original_response_headers);
+  HeaderMap merged_headers = original_headers;
+  bool headers_changed = false;
+
+  auto merged = gin_helper::Dictionary::CreateEmpty(isolate);
+  for (const auto& value : base::Reversed(request.responses)) {
+    v8::Local<v8::Value> local = value.Get(isolate);
+    if (!local->IsObject())
+      continue;
+    gin_helper::Dictionary dict(isolate, local.As<v8::Object>());
+
+    v8::Local<v8::Value> field;
+    if (dict.Get("redirectURL", &field))
+      merged.Set("redirectURL", field);
+    if (dict.Get("statusLine", &field))
+      merged.Set("statusLine", field);
+
+    if (request.request_headers && dict.Get("requestHeaders", &field) &&
+        field->IsObject()) {
+      net::HttpRequestHeaders changed;
+      gin::Converter<net::HttpRequestHeaders>::FromV8(isolate, field,
+                                                      &changed);
+      ApplyHeaderChanges(original_headers, ToHeaderMap(changed),
+                         &merged_headers);
+      headers_changed = true;
+    } else if (request.override_response_headers &&
+               dict.Get("responseHeaders", &field) && field->IsObject()) {
+      auto changed = base::MakeRefCounted<net::HttpResponseHeaders>("");
+      gin::Converter<net::HttpResponseHeaders*>::FromV8(isolate, field,
+                                                        changed.get());
+      ApplyHeaderChanges(original_headers, ToHeaderMap(*changed),
+                         &merged_headers);
+      headers_changed = true;
+    }
+  }
+
+  if (headers_changed) {
+    merged.Set(request.request_headers ? "requestHeaders" : "responseHeaders",
+               HeaderMapToV8(isolate, merged_headers));
+  }
+  (this->*on_result)(id, merged.GetHandle());
 }
 
 // static
@@ -6,9 +6,15 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_WEB_REQUEST_H_
 
 #include <map>
+#include <optional>
 #include <set>
+#include <string_view>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
 #include "gin/wrappable.h"
 #include "shell/browser/net/web_request_api_interface.h"
 
@@ -118,6 +124,19 @@ class WebRequest final : public gin::Wrappable<WebRequest>,
   using ResponseCallback = base::OnceCallback<void(v8::Local<v8::Value>)>;
   using ResponseListener =
       base::RepeatingCallback<void(v8::Local<v8::Value>, ResponseCallback)>;
+  using ListenerResultHandler = void (WebRequest::*)(uint64_t,
+                                                     v8::Local<v8::Value>);
+
+  class RequestFilter;
+
+  static std::optional<SimpleEvent> ParseSimpleEvent(std::string_view name);
+  static std::optional<ResponseEvent> ParseResponseEvent(std::string_view name);
+
+  // Parses the optional |filter| argument and leaves the argument following
+  // it in |next|. Returns false if an exception has been thrown.
+  static bool ParseFilter(gin::Arguments* args,
+                          RequestFilter* filter,
+                          v8::Local<v8::Value>* next);
 
   template <SimpleEvent event>
   void SetSimpleListener(gin::Arguments* args);
@@ -126,10 +145,32 @@ class WebRequest final : public gin::Wrappable<WebRequest>,
   template <typename Listener, typename Listeners, typename Event>
   void SetListener(Event event, Listeners* listeners, gin::Arguments* args);
 
+  void AddListener(gin::Arguments* args);
+  void RemoveListener(gin::Arguments* args);
+  template <typename Listener, typename Listeners, typename Event>
+  void AddListenerForEvent(Event event,
+                           Listeners* listeners,
+                           gin::Arguments* args);
+
+  void SetObserver(gin::Arguments* args);
+
+  // Queues an observation of |event| for the observer set with setObserver(),
+  // to be delivered in a batch later. |details| holds event-specific fields.
+  void Observe(std::string_view event,
+               extensions::WebRequestInfo* info,
+               base::Value::Dict details = {});
+  void FlushObservations();
+
   template <typename... Args>
   void HandleSimpleEvent(SimpleEvent event,
                          extensions::WebRequestInfo* info,
-                         Args... args);
+                         const Args&... args);
+  template <typename... Args>
+  int HandleResponseEvent(ResponseEvent event,
+                          extensions::WebRequestInfo* info,
+                          BlockedRequest blocked_request,
+                          ListenerResultHandler on_result,
+                          const Args&... args);
 
   int HandleOnBeforeRequestResponseEvent(
       extensions::WebRequestInfo* info,
@@ -155,6 +196,14 @@ class WebRequest final : public gin::Wrappable<WebRequest>,
   void OnHeadersReceivedListenerResult(uint64_t id,
                                        v8::Local<v8::Value> response);
 
+  // Collects the response of the |index|-th of several listeners, and passes
+  // the merged response to |on_result| once every listener has responded or
+  // one of them has cancelled the request.
+  void OnPartialListenerResult(uint64_t id,
+                               size_t index,
+                               ListenerResultHandler on_result,
+                               v8::Local<v8::Value> response);
+
   class RequestFilter {
    public:
     RequestFilter(std::set<URLPattern>,
@@ -186,8 +235,15 @@ class WebRequest final : public gin::Wrappable<WebRequest>,
   struct SimpleListenerInfo {
     RequestFilter filter;
     SimpleListener listener;
+    // Listeners with a higher priority are invoked first.
+    int priority = 0;
+    // The function passed to addListener(), used to find the listener again
+    // in removeListener(). Empty for the listener set with on<Event>().
+    v8::Global<v8::Value> function;
 
     SimpleListenerInfo(RequestFilter, SimpleListener);
+    SimpleListenerInfo(SimpleListenerInfo&&);
+    SimpleListenerInfo& operator=(SimpleListenerInfo&&);
     SimpleListenerInfo();
     ~SimpleListenerInfo();
   };
@@ -195,16 +251,32 @@ class WebRequest final : public gin::Wrappable<WebRequest>,
   struct ResponseListenerInfo {
     RequestFilter filter;
     ResponseListener listener;
+    // Listeners with a higher priority are invoked first.
+    int priority = 0;
+    // The function passed to addListener(), used to find the listener again
+    // in removeListener(). Empty for the listener set with on<Event>().
+    v8::Global<v8::Value> function;
 
     ResponseListenerInfo(RequestFilter, ResponseListener);
+    ResponseListenerInfo(ResponseListenerInfo&&);
+    ResponseListenerInfo& operator=(ResponseListenerInfo&&);
     ResponseListenerInfo();
     ~ResponseListenerInfo();
   };
 
-  std::map<SimpleEvent, SimpleListenerInfo> simple_listeners_;
-  std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
+  // Listeners of each event, sorted by descending priority.
+  std::map<SimpleEvent, std::vector<SimpleListenerInfo>> simple_listeners_;
+  std::map<ResponseEvent, std::vector<ResponseListenerInfo>>
+      response_listeners_;
   std::map<uint64_t, BlockedRequest> blocked_requests_;
 
+  // The passive observer, which never blocks requests and receives its
+  // observations in batches every |observer_interval_|.
+  std::optional<SimpleListenerInfo> observer_;
+  base::TimeDelta observer_interval_;
+  base::OneShotTimer observer_timer_;
+  base::Value::List observations_;
+
   // Weak-ref, it manages us.
   raw_ptr<content::BrowserContext> browser_context_;
 };
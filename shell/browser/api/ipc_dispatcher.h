@@ -17,6 +17,7 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event.h"
 #include "shell/common/gin_helper/reply_channel.h"
+#include "shell/common/task_attribution.h"
 #include "shell/common/v8_util.h"
 
 namespace electron {
@@ -30,6 +31,7 @@ class IpcDispatcher {
                const std::string& channel,
                blink::CloneableMessage args) {
     TRACE_EVENT1("electron", "IpcDispatcher::Message", "channel", channel);
+    task_attribution::Record("ipc", channel);
     emitter()->EmitWithoutEvent("-ipc-message", event, channel, args);
   }
 
@@ -37,6 +39,7 @@ class IpcDispatcher {
               const std::string& channel,
               blink::CloneableMessage arguments) {
     TRACE_EVENT1("electron", "IpcDispatcher::Invoke", "channel", channel);
+    task_attribution::Record("ipc", channel);
     emitter()->EmitWithoutEvent("-ipc-invoke", event, channel,
                                 std::move(arguments));
   }
@@ -46,6 +49,7 @@ class IpcDispatcher {
                           blink::TransferableMessage message) {
     TRACE_EVENT1("electron", "IpcDispatcher::ReceivePostMessage", "channel",
                  channel);
+    task_attribution::Record("ipc", channel);
     v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
     v8::HandleScope handle_scope(isolate);
     auto wrapped_ports =
@@ -60,6 +64,7 @@ class IpcDispatcher {
                    const std::string& channel,
                    blink::CloneableMessage arguments) {
     TRACE_EVENT1("electron", "IpcDispatcher::MessageSync", "channel", channel);
+    task_attribution::Record("ipc", channel);
     emitter()->EmitWithoutEvent("-ipc-message-sync", event, channel,
                                 std::move(arguments));
   }
@@ -68,6 +73,7 @@ class IpcDispatcher {
                    const std::string& channel,
                    blink::CloneableMessage arguments) {
     TRACE_EVENT1("electron", "IpcDispatcher::MessageHost", "channel", channel);
+    task_attribution::Record("ipc", channel);
     emitter()->EmitWithoutEvent("-ipc-message-host", event, channel,
                                 std::move(arguments));
   }
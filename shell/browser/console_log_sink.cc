@@ -0,0 +1,213 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/console_log_sink.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/strings/pattern.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/values.h"
+#include "build/build_config.h"
+#include "third_party/blink/public/mojom/devtools/console_message.mojom.h"
+
+#if BUILDFLAG(IS_POSIX)
+#include <fcntl.h>
+
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+// Batches are handed to the writer early once they grow this large.
+constexpr size_t kMaxPendingBytes = 64 * 1024;
+
+std::string_view LevelToString(blink::mojom::ConsoleMessageLevel level) {
+  switch (level) {
+    case blink::mojom::ConsoleMessageLevel::kVerbose:
+      return "debug";
+    case blink::mojom::ConsoleMessageLevel::kInfo:
+      return "info";
+    case blink::mojom::ConsoleMessageLevel::kWarning:
+      return "warning";
+    case blink::mojom::ConsoleMessageLevel::kError:
+      return "error";
+  }
+  return "info";
+}
+
+}  // namespace
+
+// Owns the output and lives on a background sequence.
+class ConsoleLogSink::Writer {
+ public:
+  Writer(base::FilePath path,
+         bool is_pipe,
+         int64_t max_file_size,
+         int max_files)
+      : path_(std::move(path)),
+        is_pipe_(is_pipe),
+        max_file_size_(max_file_size),
+        max_files_(max_files) {}
+
+  // disable copy
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  void Write(const std::string& batch) {
+    if (!file_.IsValid() && !Open())
+      return;
+
+    if (!is_pipe_ && size_ > 0 &&
+        size_ + static_cast<int64_t>(batch.size()) > max_file_size_) {
+      Rotate();
+      if (!file_.IsValid())
+        return;
+    }
+
+    // Reopen on the next batch, e.g. after the reader of a pipe went away.
+    if (!file_.WriteAtCurrentPosAndCheck(base::as_byte_span(batch))) {
+      file_.Close();
+      return;
+    }
+    size_ += batch.size();
+  }
+
+ private:
+  bool Open() {
+#if BUILDFLAG(IS_POSIX)
+    if (is_pipe_)
+      return OpenFifo();
+#endif
+    file_.Initialize(path_, is_pipe_ ? base::File::FLAG_OPEN |
+                                           base::File::FLAG_WRITE
+                                     : base::File::FLAG_OPEN_ALWAYS |
+                                           base::File::FLAG_APPEND);
+    if (!file_.IsValid())
+      return false;
+    size_ = is_pipe_ ? 0 : std::max<int64_t>(file_.GetLength(), 0);
+    return true;
+  }
+
+#if BUILDFLAG(IS_POSIX)
+  // A blocking open() of a FIFO waits for a reader forever, so open it
+  // non-blocking, which fails without a reader, and drop the batch then.
+  // Writes block again so that lines are never split.
+  bool OpenFifo() {
+    base::ScopedFD fd(HANDLE_EINTR(
+        open(path_.value().c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC)));
+    if (!fd.is_valid())
+      return false;
+    const int flags = fcntl(fd.get(), F_GETFL);
+    if (flags == -1 || fcntl(fd.get(), F_SETFL, flags & ~O_NONBLOCK) == -1)
+      return false;
+    file_ = base::File(fd.release());
+    size_ = 0;
+    return true;
+  }
+#endif
+
+  // <path> becomes <path>.1, <path>.1 becomes <path>.2 and so on, dropping
+  // the oldest file.
+  void Rotate() {
+    file_.Close();
+    for (int i = max_files_ - 1; i > 0; --i) {
+      base::Move(i == 1 ? path_ : RotatedPath(i - 1), RotatedPath(i));
+    }
+    if (max_files_ <= 1)
+      base::DeleteFile(path_);
+    Open();
+  }
+
+  base::FilePath RotatedPath(int index) const {
+    return path_.AddExtensionASCII(base::NumberToString(index));
+  }
+
+  const base::FilePath path_;
+  const bool is_pipe_;
+  const int64_t max_file_size_;
+  const int max_files_;
+
+  base::File file_;
+  int64_t size_ = 0;
+};
+
+ConsoleLogSink::Options::Options() = default;
+ConsoleLogSink::Options::Options(const Options&) = default;
+ConsoleLogSink::Options& ConsoleLogSink::Options::operator=(const Options&) =
+    default;
+ConsoleLogSink::Options::~Options() = default;
+
+ConsoleLogSink::ConsoleLogSink(Options options)
+    : options_(std::move(options)),
+      source_pattern_(base::UTF8ToUTF16(options_.source_pattern)),
+      // Pending messages make it to a file before quitting, but a pipe whose
+      // reader stopped reading must not keep the app from quitting.
+      writer_(base::ThreadPool::CreateSequencedTaskRunner(
+                  {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+                   options_.is_pipe
+                       ? base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN
+                       : base::TaskShutdownBehavior::BLOCK_SHUTDOWN}),
+              options_.path,
+              options_.is_pipe,
+              options_.max_file_size,
+              options_.max_files) {}
+
+ConsoleLogSink::~ConsoleLogSink() {
+  Flush();
+}
+
+bool ConsoleLogSink::Matches(blink::mojom::ConsoleMessageLevel level,
+                             std::u16string_view source_id) const {
+  if (!options_.levels.empty() && !options_.levels.contains(level))
+    return false;
+  return source_pattern_.empty() ||
+         base::MatchPattern(source_id, source_pattern_);
+}
+
+void ConsoleLogSink::Add(int32_t web_contents_id,
+                         blink::mojom::ConsoleMessageLevel level,
+                         std::u16string_view message,
+                         int32_t line_number,
+                         std::u16string_view source_id) {
+  std::optional<std::string> line = base::WriteJson(
+      base::Value::Dict()
+          .Set("time", base::Time::Now().InMillisecondsFSinceUnixEpoch())
+          .Set("level", LevelToString(level))
+          .Set("message", message)
+          .Set("sourceId", source_id)
+          .Set("lineNumber", line_number)
+          .Set("webContentsId", web_contents_id));
+  if (!line)
+    return;
+  pending_.append(*line);
+  pending_.push_back('\n');
+
+  if (pending_.size() >= kMaxPendingBytes) {
+    Flush();
+  } else if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, options_.flush_interval,
+                       base::BindOnce(&ConsoleLogSink::Flush,
+                                      base::Unretained(this)));
+  }
+}
+
+void ConsoleLogSink::Flush() {
+  flush_timer_.Stop();
+  if (pending_.empty())
+    return;
+  writer_.AsyncCall(&Writer::Write).WithArgs(std::exchange(pending_, {}));
+}
+
+}  // namespace electron
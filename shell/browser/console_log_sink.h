@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_CONSOLE_LOG_SINK_H_
+#define ELECTRON_SHELL_BROWSER_CONSOLE_LOG_SINK_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "base/containers/flat_set.h"
+#include "base/files/file_path.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "third_party/blink/public/mojom/devtools/console_message.mojom-forward.h"
+
+namespace electron {
+
+// Writes the console messages of a session's pages to a file or a pipe,
+// without emitting them into JS. Messages are filtered and batched on the UI
+// thread and written on a background sequence.
+class ConsoleLogSink {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    Options& operator=(const Options&);
+    ~Options();
+
+    // Log file that is rotated once it reaches |max_file_size|, keeping
+    // |max_files| - 1 older files named "<path>.1", "<path>.2"...
+    base::FilePath path;
+    // An existing FIFO or named pipe to write to instead of a file. It is
+    // never rotated.
+    bool is_pipe = false;
+    int64_t max_file_size = 10 * 1024 * 1024;
+    int max_files = 3;
+    // Levels to keep, all when empty.
+    base::flat_set<blink::mojom::ConsoleMessageLevel> levels;
+    // base::MatchPattern() pattern the source URL has to match, all when
+    // empty.
+    std::string source_pattern;
+    base::TimeDelta flush_interval = base::Seconds(1);
+    // Whether messages kept by the sink are also emitted as
+    // 'console-message' events.
+    bool emit_events = false;
+  };
+
+  explicit ConsoleLogSink(Options options);
+  ~ConsoleLogSink();
+
+  // disable copy
+  ConsoleLogSink(const ConsoleLogSink&) = delete;
+  ConsoleLogSink& operator=(const ConsoleLogSink&) = delete;
+
+  // Whether the message passes the filters of the sink.
+  bool Matches(blink::mojom::ConsoleMessageLevel level,
+               std::u16string_view source_id) const;
+
+  // Queues a message that |Matches()|.
+  void Add(int32_t web_contents_id,
+           blink::mojom::ConsoleMessageLevel level,
+           std::u16string_view message,
+           int32_t line_number,
+           std::u16string_view source_id);
+
+  // Hands the queued messages to the writer.
+  void Flush();
+
+  bool emit_events() const { return options_.emit_events; }
+
+ private:
+  class Writer;
+
+  const Options options_;
+  const std::u16string source_pattern_;
+  base::SequenceBound<Writer> writer_;
+
+  // JSON lines waiting to be written.
+  std::string pending_;
+  base::OneShotTimer flush_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_CONSOLE_LOG_SINK_H_
@@ -12,6 +12,7 @@
 #include <string_view>
 #include <utility>
 
+#include "base/auto_reset.h"
 #include "base/base_switches.h"
 #include "base/command_line.h"
 #include "base/debug/crash_logging.h"
@@ -116,6 +117,7 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
 #include "shell/common/plugin.mojom.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/web_contents_utility.mojom.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
@@ -384,6 +386,8 @@ bool ElectronBrowserClient::IsRendererSubFrame(
 
 void ElectronBrowserClient::RenderProcessWillLaunch(
     content::RenderProcessHost* host) {
+  startup_timeline::Mark("firstRendererLaunch");
+
   // Remove in case the host is reused after a crash, otherwise noop.
   host->RemoveObserver(this);
 
@@ -446,7 +450,14 @@ void ElectronBrowserClient::RegisterPendingSiteInstance(
     content::SiteInstance* pending_site_instance) {
   // Remember the original web contents for the pending renderer process.
   auto* web_contents = content::WebContents::FromRenderFrameHost(rfh);
-  auto* pending_process = pending_site_instance->GetProcess();
+  // Picking the process consults IsSuitableHost(), which needs to know who
+  // is navigating.
+  content::RenderProcessHost* pending_process;
+  {
+    base::AutoReset<raw_ptr<content::RenderFrameHost>> navigating_frame(
+        &navigating_frame_, rfh);
+    pending_process = pending_site_instance->GetProcess();
+  }
   pending_processes_[pending_process->GetID()] = web_contents;
 
   if (rfh->GetParent())
@@ -746,9 +757,44 @@ void ElectronBrowserClient::SiteInstanceGotProcessAndSite(
 #endif  // BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 }
 
+bool ElectronBrowserClient::IsCompatibleHost(
+    content::RenderProcessHost* process_host) {
+  // Only the process limit and process-per-site origins can hand a frame a
+  // process launched for another WebContents, so otherwise keep Chromium's
+  // own reuse decisions.
+  auto* browser_context =
+      static_cast<ElectronBrowserContext*>(process_host->GetBrowserContext());
+  if (!has_renderer_process_limit_ &&
+      browser_context->process_per_site_sites().empty())
+    return true;
+  // Callers other than navigations, e.g. service workers joining their
+  // page's process, have no webPreferences of their own to compare.
+  if (!navigating_frame_)
+    return true;
+
+  content::WebContents* host_contents =
+      GetWebContentsFromProcessID(process_host->GetID());
+  auto* host_prefs = WebContentsPreferences::From(host_contents);
+  // Processes not launched for a WebContents of ours have no settings to
+  // conflict with.
+  if (!host_prefs)
+    return true;
+  auto* prefs = WebContentsPreferences::From(
+      content::WebContents::FromRenderFrameHost(navigating_frame_));
+  return prefs && prefs->CanShareProcessWith(*host_prefs) &&
+         IsRendererSubFrame(process_host->GetID()) ==
+             (navigating_frame_->GetParent() != nullptr);
+}
+
 bool ElectronBrowserClient::IsSuitableHost(
     content::RenderProcessHost* process_host,
     const GURL& site_url) {
+  // Process-per-site origins and the renderer process limit make Chromium
+  // reuse processes of other WebContents, which must not hand a window the
+  // Node.js integration or sandbox settings of another.
+  if (!IsCompatibleHost(process_host))
+    return false;
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   auto* browser_context = process_host->GetBrowserContext();
   extensions::ProcessMap* process_map =
@@ -766,6 +812,13 @@ bool ElectronBrowserClient::IsSuitableHost(
 bool ElectronBrowserClient::ShouldUseProcessPerSite(
     content::BrowserContext* browser_context,
     const GURL& effective_url) {
+  const auto& sites = static_cast<ElectronBrowserContext*>(browser_context)
+                          ->process_per_site_sites();
+  if (!sites.empty() &&
+      sites.contains(
+          content::SiteInstance::GetSiteForURL(browser_context, effective_url)))
+    return true;
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   const extensions::Extension* extension =
       GetEnabledExtensionFromEffectiveURL(browser_context, effective_url);
@@ -65,6 +65,11 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
   using Delegate = content::ContentBrowserClient;
   void set_delegate(Delegate* delegate) { delegate_ = delegate; }
 
+  // Set when app.setRendererProcessLimit() caps the number of processes.
+  void set_has_renderer_process_limit(bool has_limit) {
+    has_renderer_process_limit_ = has_limit;
+  }
+
   // Returns the WebContents for pending render processes.
   content::WebContents* GetWebContentsFromProcessID(
       content::ChildProcessId process_id);
@@ -332,12 +337,21 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
 
   bool IsRendererSubFrame(content::ChildProcessId process_id) const;
 
+  // Whether |process_host| was launched with the same webPreferences as
+  // |navigating_frame_| would get.
+  bool IsCompatibleHost(content::RenderProcessHost* process_host);
+
   // pending_render_process => web contents.
   base::flat_map<content::ChildProcessId, content::WebContents*>
       pending_processes_;
 
   base::flat_set<content::ChildProcessId> renderer_is_subframe_;
 
+  // The frame whose renderer process is being picked, if any.
+  raw_ptr<content::RenderFrameHost> navigating_frame_ = nullptr;
+
+  bool has_renderer_process_limit_ = false;
+
   std::unique_ptr<PlatformNotificationService> notification_service_;
   std::unique_ptr<NotificationPresenter> notification_presenter_;
 
@@ -23,6 +23,7 @@
 #include "chrome/common/pref_names.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
 #include "components/prefs/json_pref_store.h"
+#include "components/prefs/overlay_user_pref_store.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/pref_service_factory.h"
@@ -43,12 +44,14 @@
 #include "services/network/public/cpp/url_loader_factory_builder.h"
 #include "services/network/public/cpp/wrapper_shared_url_loader_factory.h"
 #include "services/network/public/mojom/network_context.mojom.h"
+#include "shell/browser/console_log_sink.h"
 #include "shell/browser/cookie_change_notifier.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/file_system_access/file_system_access_permission_context_factory.h"
+#include "shell/browser/log_pref_store.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/browser/serial/serial_chooser_context.h"
@@ -334,6 +337,10 @@ ElectronBrowserContext::ElectronBrowserContext(
     use_cache_ = use_cache_opt.value();
   }
 
+  if (const std::string* store = options.FindString("preferencesStore")) {
+    use_log_pref_store_ = *store == "log";
+  }
+
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
 
@@ -392,10 +399,29 @@ void ElectronBrowserContext::InitPrefs() {
   auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
   ScopedAllowBlockingForElectron allow_blocking;
   PrefServiceFactory prefs_factory;
-  scoped_refptr<JsonPrefStore> pref_store =
-      base::MakeRefCounted<JsonPrefStore>(prefs_path);
-  pref_store->ReadPrefs();  // Synchronous.
-  prefs_factory.set_user_prefs(pref_store);
+  if (in_memory_) {
+    // In-memory sessions share |path_| with the default session. They start
+    // from the default session's prefs on disk, like a new session would read
+    // them, but keep their own changes in memory so that they never rewrite
+    // the default session's Preferences file. A LogPrefStore reads the prefs
+    // whichever store the default session uses, and never writes here.
+    auto default_prefs = base::MakeRefCounted<LogPrefStore>(prefs_path);
+    default_prefs->ReadPrefs();  // Synchronous.
+    prefs_factory.set_user_prefs(
+        base::MakeRefCounted<OverlayUserPrefStore>(default_prefs.get()));
+  } else if (use_log_pref_store_) {
+    log_pref_store_ = base::MakeRefCounted<LogPrefStore>(prefs_path);
+    log_pref_store_->ReadPrefs();  // Synchronous.
+    prefs_factory.set_user_prefs(log_pref_store_);
+  } else {
+    // Don't lose the changes still in the log of a LogPrefStore, in case the
+    // session used one before.
+    LogPrefStore::MergeLogIntoSnapshot(prefs_path);
+    scoped_refptr<JsonPrefStore> pref_store =
+        base::MakeRefCounted<JsonPrefStore>(prefs_path);
+    pref_store->ReadPrefs();  // Synchronous.
+    prefs_factory.set_user_prefs(pref_store);
+  }
   prefs_factory.set_command_line_prefs(in_memory_pref_store());
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -628,6 +654,11 @@ network::mojom::SSLConfigPtr ElectronBrowserContext::GetSSLConfig() {
   return ssl_config_.Clone();
 }
 
+void ElectronBrowserContext::SetConsoleLogSink(
+    std::unique_ptr<ConsoleLogSink> sink) {
+  console_log_sink_ = std::move(sink);
+}
+
 void ElectronBrowserContext::SetSSLConfig(network::mojom::SSLConfigPtr config) {
   ssl_config_ = std::move(config);
   if (ssl_config_client_) {
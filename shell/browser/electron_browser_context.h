@@ -10,9 +10,11 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/browser_context.h"
@@ -23,6 +25,7 @@
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/network/public/mojom/ssl_config.mojom.h"
 #include "third_party/blink/public/common/permissions/permission_utils.h"
+#include "url/gurl.h"
 
 class PrefService;
 class ValueMapPrefStore;
@@ -51,9 +54,11 @@ class ElectronExtensionSystem;
 
 namespace electron {
 
+class ConsoleLogSink;
 class ElectronDownloadManagerDelegate;
 class ElectronPermissionManager;
 class CookieChangeNotifier;
+class LogPrefStore;
 class ResolveProxyHelper;
 class WebViewManager;
 class ProtocolRegistry;
@@ -150,6 +155,8 @@ class ElectronBrowserContext : public content::BrowserContext {
   ValueMapPrefStore* in_memory_pref_store() const {
     return in_memory_pref_store_.get();
   }
+  // Null unless the session was created with the "log" preferences store.
+  LogPrefStore* log_pref_store() const { return log_pref_store_.get(); }
   base::WeakPtr<ElectronBrowserContext> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
   }
@@ -167,6 +174,10 @@ class ElectronBrowserContext : public content::BrowserContext {
     return protocol_registry_.get();
   }
 
+  // Receives the console messages of the pages in this session, if set.
+  ConsoleLogSink* console_log_sink() const { return console_log_sink_.get(); }
+  void SetConsoleLogSink(std::unique_ptr<ConsoleLogSink> sink);
+
   void SetSSLConfig(network::mojom::SSLConfigPtr config);
   network::mojom::SSLConfigPtr GetSSLConfig();
   void SetSSLConfigClient(mojo::Remote<network::mojom::SSLConfigClient> client);
@@ -175,6 +186,14 @@ class ElectronBrowserContext : public content::BrowserContext {
                                 content::MediaResponseCallback callback);
   void SetDisplayMediaRequestHandler(DisplayMediaRequestHandler handler);
 
+  // Sites whose documents should all share a single renderer process.
+  void set_process_per_site_sites(base::flat_set<GURL> sites) {
+    process_per_site_sites_ = std::move(sites);
+  }
+  const base::flat_set<GURL>& process_per_site_sites() const {
+    return process_per_site_sites_;
+  }
+
   ~ElectronBrowserContext() override;
 
   // Grants |origin| access to |device|.
@@ -220,6 +239,7 @@ class ElectronBrowserContext : public content::BrowserContext {
   void InitPrefs();
 
   scoped_refptr<ValueMapPrefStore> in_memory_pref_store_;
+  scoped_refptr<LogPrefStore> log_pref_store_;
   std::unique_ptr<CookieChangeNotifier> cookie_change_notifier_;
   std::unique_ptr<PrefService> prefs_;
   std::unique_ptr<ElectronDownloadManagerDelegate> download_manager_delegate_;
@@ -230,11 +250,13 @@ class ElectronBrowserContext : public content::BrowserContext {
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
+  std::unique_ptr<ConsoleLogSink> console_log_sink_;
 
   std::optional<std::string> user_agent_;
   base::FilePath path_;
   bool in_memory_ = false;
   bool use_cache_ = true;
+  bool use_log_pref_store_ = false;
   int max_cache_size_ = 0;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -250,6 +272,8 @@ class ElectronBrowserContext : public content::BrowserContext {
 
   DisplayMediaRequestHandler display_media_request_handler_;
 
+  base::flat_set<GURL> process_per_site_sites_;
+
   // In-memory cache that holds objects that have been granted permissions.
   DevicePermissionMap granted_devices_;
 
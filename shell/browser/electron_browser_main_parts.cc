@@ -63,6 +63,7 @@
 #include "shell/common/logging.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/base/ui_base_switches.h"
@@ -205,6 +206,7 @@ int ElectronBrowserMainParts::GetExitCode() const {
 }
 
 int ElectronBrowserMainParts::PreEarlyInitialization() {
+  startup_timeline::ScopedPhase phase("preEarlyInitialization");
   field_trial_list_ = std::make_unique<base::FieldTrialList>();
 #if BUILDFLAG(IS_POSIX)
   HandleSIGCHLD();
@@ -224,6 +226,7 @@ int ElectronBrowserMainParts::PreEarlyInitialization() {
 }
 
 void ElectronBrowserMainParts::PostEarlyInitialization() {
+  startup_timeline::ScopedPhase phase("postEarlyInitialization");
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::SingleThreadTaskRunner::HasCurrentDefault());
@@ -236,9 +239,12 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 
   node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
   // Create the global environment.
-  node_env_ = node_bindings_->CreateEnvironment(
-      js_env_->isolate()->GetCurrentContext(), js_env_->platform(),
-      js_env_->max_young_generation_size_in_bytes());
+  {
+    startup_timeline::ScopedPhase create_phase("createNodeEnvironment");
+    node_env_ = node_bindings_->CreateEnvironment(
+        js_env_->isolate()->GetCurrentContext(), js_env_->platform(),
+        js_env_->max_young_generation_size_in_bytes());
+  }
 
   node_env_->set_trace_sync_io(node_env_->options()->trace_sync_io);
 
@@ -254,11 +260,15 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   // Wrap the uv loop with global env.
   node_bindings_->set_uv_env(node_env_.get());
 
-  // Load everything.
-  node_bindings_->LoadEnvironment(node_env_.get());
+  {
+    startup_timeline::ScopedPhase load_phase("loadAppCode");
+
+    // Load everything.
+    node_bindings_->LoadEnvironment(node_env_.get());
 
-  // Wait for app
-  node_bindings_->JoinAppCode();
+    // Wait for app
+    node_bindings_->JoinAppCode();
+  }
 
   // We already initialized the feature list in PreEarlyInitialization(), but
   // the user JS script would not have had a chance to alter the command-line
@@ -280,6 +290,7 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 }
 
 int ElectronBrowserMainParts::PreCreateThreads() {
+  startup_timeline::ScopedPhase phase("preCreateThreads");
   if (!views::LayoutProvider::Get()) {
     layout_provider_ = std::make_unique<views::LayoutProvider>();
   }
@@ -316,7 +327,11 @@ int ElectronBrowserMainParts::PreCreateThreads() {
 #endif
 
   // Load resources bundle according to locale.
-  std::string loaded_locale = LoadResourceBundle(locale);
+  std::string loaded_locale;
+  {
+    startup_timeline::ScopedPhase load_phase("loadResourceBundle");
+    loaded_locale = LoadResourceBundle(locale);
+  }
 
 #if defined(USE_AURA)
   // NB: must be called _after_ locale resource bundle is loaded,
@@ -388,6 +403,7 @@ void ElectronBrowserMainParts::PostDestroyThreads() {
 }
 
 void ElectronBrowserMainParts::ToolkitInitialized() {
+  startup_timeline::ScopedPhase phase("toolkitInitialized");
 #if BUILDFLAG(IS_LINUX)
   auto* linux_ui = ui::GetDefaultLinuxUi();
   CHECK(linux_ui);
@@ -425,6 +441,7 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 int ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  startup_timeline::ScopedPhase phase("preMainMessageLoopRun");
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareEmbedThread();
@@ -494,6 +511,7 @@ void ElectronBrowserMainParts::WillRunMainMessageLoop(
 }
 
 void ElectronBrowserMainParts::PostCreateMainMessageLoop() {
+  startup_timeline::ScopedPhase phase("postCreateMainMessageLoop");
 #if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_MAC)
   std::string app_name = electron::Browser::Get()->GetName();
 #endif
@@ -13,6 +13,7 @@
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_helper/event.h"
 #include "shell/common/gin_helper/event_emitter.h"
+#include "shell/common/task_attribution.h"
 
 namespace gin_helper {
 
@@ -27,6 +28,7 @@ class EventEmitterMixin {
   // Returns true if event.preventDefault() was called during processing.
   template <typename... Args>
   bool Emit(const std::string_view name, Args&&... args) {
+    electron::task_attribution::Record("event", name);
     v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
     v8::HandleScope handle_scope(isolate);
     v8::Local<v8::Object> wrapper;
@@ -41,6 +43,7 @@ class EventEmitterMixin {
   // this.emit(name, args...);
   template <typename... Args>
   void EmitWithoutEvent(const std::string_view name, Args&&... args) {
+    electron::task_attribution::Record("event", name);
     v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
     v8::HandleScope handle_scope(isolate);
     v8::Local<v8::Object> wrapper;
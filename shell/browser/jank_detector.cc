@@ -0,0 +1,232 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/jank_detector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/pending_task.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/task/current_thread.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/thread_annotations.h"
+#include "base/timer/timer.h"
+#include "gin/converter.h"
+#include "shell/common/task_attribution.h"
+#include "v8/include/v8-debug.h"
+#include "v8/include/v8-isolate.h"
+
+namespace electron {
+
+namespace {
+
+constexpr int kMaxStackFrames = 32;
+
+std::string CaptureStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> trace =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string stack;
+  for (int i = 0; i < trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, i);
+    v8::Local<v8::String> function_name = frame->GetFunctionName();
+    v8::Local<v8::String> script_name = frame->GetScriptName();
+    if (!stack.empty())
+      stack.push_back('\n');
+    base::StrAppend(
+        &stack,
+        {"    at ",
+         function_name.IsEmpty() || function_name->Length() == 0
+             ? "<anonymous>"
+             : gin::V8ToString(isolate, function_name),
+         " (",
+         script_name.IsEmpty() ? "<unknown>"
+                               : gin::V8ToString(isolate, script_name),
+         ":", base::NumberToString(frame->GetLineNumber()), ":",
+         base::NumberToString(frame->GetColumn()), ")"});
+  }
+  return stack;
+}
+
+}  // namespace
+
+// Shares the running task of the UI thread with the watchdog.
+class JankDetector::State : public base::RefCountedThreadSafe<State> {
+ public:
+  explicit State(v8::Isolate* isolate) : isolate_(isolate) {}
+
+  // disable copy
+  State(const State&) = delete;
+  State& operator=(const State&) = delete;
+
+  // Called on the UI thread.
+  void TaskStarted(base::TimeTicks start_time) {
+    base::AutoLock lock(lock_);
+    ++task_id_;
+    task_start_time_ = start_time;
+    stack_.clear();
+  }
+
+  // Called on the UI thread. Returns the stack captured for the task.
+  std::string TaskEnded() {
+    base::AutoLock lock(lock_);
+    task_start_time_ = base::TimeTicks();
+    return std::move(stack_);
+  }
+
+  // Called on the UI thread before the isolate can go away.
+  void Detach() {
+    base::AutoLock lock(lock_);
+    isolate_ = nullptr;
+  }
+
+  // Called on the watchdog's sequence. Asks for the JS stack of the running
+  // task once it ran for |threshold|. The interrupt only runs once the UI
+  // thread executes JS, so tasks stuck in native code get no stack.
+  void CheckRunningTask(base::TimeDelta threshold) {
+    base::AutoLock lock(lock_);
+    if (!isolate_ || task_start_time_.is_null() ||
+        interrupted_task_id_ == task_id_ ||
+        base::TimeTicks::Now() - task_start_time_ < threshold)
+      return;
+    interrupted_task_id_ = task_id_;
+    // Released by OnInterrupt().
+    AddRef();
+    isolate_->RequestInterrupt(&State::OnInterrupt, this);
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<State>;
+
+  ~State() = default;
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    auto* self = static_cast<State*>(data);
+    std::string stack = CaptureStack(isolate);
+    {
+      base::AutoLock lock(self->lock_);
+      // The task may have ended before JS ran again.
+      if (self->isolate_ == isolate && !self->task_start_time_.is_null() &&
+          self->task_id_ == self->interrupted_task_id_)
+        self->stack_ = std::move(stack);
+    }
+    self->Release();
+  }
+
+  base::Lock lock_;
+  raw_ptr<v8::Isolate> isolate_ GUARDED_BY(lock_);
+  uint64_t task_id_ GUARDED_BY(lock_) = 0;
+  uint64_t interrupted_task_id_ GUARDED_BY(lock_) = 0;
+  // Null while no task is being tracked.
+  base::TimeTicks task_start_time_ GUARDED_BY(lock_);
+  std::string stack_ GUARDED_BY(lock_);
+};
+
+// Polls the running task from a background sequence, since the UI thread
+// can't notice that it's stuck.
+class JankDetector::Watchdog {
+ public:
+  Watchdog(scoped_refptr<State> state, base::TimeDelta stack_threshold) {
+    // A quarter of the threshold keeps the stack close to the threshold
+    // without waking up often.
+    timer_.Start(FROM_HERE,
+                 std::max(stack_threshold / 4, base::Milliseconds(10)),
+                 base::BindRepeating(&State::CheckRunningTask,
+                                     std::move(state), stack_threshold));
+  }
+
+  // disable copy
+  Watchdog(const Watchdog&) = delete;
+  Watchdog& operator=(const Watchdog&) = delete;
+
+ private:
+  base::RepeatingTimer timer_;
+};
+
+JankDetector::LongTask::LongTask() = default;
+JankDetector::LongTask::LongTask(const LongTask&) = default;
+JankDetector::LongTask& JankDetector::LongTask::operator=(const LongTask&) =
+    default;
+JankDetector::LongTask::~LongTask() = default;
+
+JankDetector::JankDetector(v8::Isolate* isolate,
+                           const Options& options,
+                           Callback callback)
+    : options_(options),
+      callback_(std::move(callback)),
+      state_(base::MakeRefCounted<State>(isolate)) {
+  if (options_.stack_threshold.is_positive()) {
+    watchdog_ = base::SequenceBound<Watchdog>(
+        base::ThreadPool::CreateSequencedTaskRunner(
+            {base::TaskPriority::USER_BLOCKING,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+        state_, options_.stack_threshold);
+  }
+  base::CurrentThread::Get()->AddTaskObserver(this);
+}
+
+JankDetector::~JankDetector() {
+  // The message loop may already be gone when destroyed during shutdown.
+  if (base::CurrentThread::IsSet())
+    base::CurrentThread::Get()->RemoveTaskObserver(this);
+  task_attribution::SetSink(nullptr);
+  state_->Detach();
+}
+
+void JankDetector::WillProcessTask(const base::PendingTask& pending_task,
+                                   bool was_blocked_or_low_priority) {
+  if (!running_tasks_.empty())
+    running_tasks_.back().nested = true;
+  const base::TimeTicks now = base::TimeTicks::Now();
+  running_tasks_.push_back({now});
+  task_attribution::SetSink(&running_tasks_.back().attribution);
+  state_->TaskStarted(now);
+}
+
+void JankDetector::DidProcessTask(const base::PendingTask& pending_task) {
+  // Tasks that started before the detector was created aren't tracked.
+  if (running_tasks_.empty())
+    return;
+
+  RunningTask task = std::move(running_tasks_.back());
+  running_tasks_.pop_back();
+  task_attribution::SetSink(running_tasks_.empty()
+                                ? nullptr
+                                : &running_tasks_.back().attribution);
+  std::string stack = state_->TaskEnded();
+
+  const base::TimeDelta duration = base::TimeTicks::Now() - task.start_time;
+  if (task.nested || duration < options_.threshold)
+    return;
+
+  const auto bucket = std::ranges::upper_bound(
+      kBucketBounds, static_cast<int>(duration.InMilliseconds()));
+  ++histogram_[std::distance(kBucketBounds.begin(), bucket) - 1];
+
+  LongTask long_task;
+  long_task.start_time = task.start_time;
+  long_task.duration = duration;
+  long_task.posted_from = pending_task.posted_from;
+  long_task.attribution = std::move(task.attribution);
+  long_task.stack = std::move(stack);
+  // Listeners shouldn't run in the middle of the task observers.
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&JankDetector::Report,
+                                weak_factory_.GetWeakPtr(),
+                                std::move(long_task)));
+}
+
+void JankDetector::Report(const LongTask& task) {
+  callback_.Run(task);
+}
+
+}  // namespace electron
@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_JANK_DETECTOR_H_
+#define ELECTRON_SHELL_BROWSER_JANK_DETECTOR_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "base/functional/callback.h"
+#include "base/location.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron {
+
+// Watches the tasks of the UI thread and reports the ones that ran for longer
+// than a threshold, which froze every window meanwhile. Each one is blamed on
+// where it was posted from and on what it dispatched to JS, see
+// task_attribution::Record(). A watchdog on a background sequence also
+// captures the JS stack of tasks that keep running for much longer.
+class JankDetector : public base::TaskObserver {
+ public:
+  struct Options {
+    base::TimeDelta threshold = base::Milliseconds(100);
+    // Zero disables capturing stacks.
+    base::TimeDelta stack_threshold = base::Seconds(1);
+  };
+
+  struct LongTask {
+    LongTask();
+    LongTask(const LongTask&);
+    LongTask& operator=(const LongTask&);
+    ~LongTask();
+
+    base::TimeTicks start_time;
+    base::TimeDelta duration;
+    base::Location posted_from;
+    // "<kind>:<name>" of the first event or IPC the task dispatched, if any.
+    std::string attribution;
+    // The JS stack once the task ran for |Options::stack_threshold|. Only
+    // available when the task was running JS at that point.
+    std::string stack;
+  };
+
+  using Callback = base::RepeatingCallback<void(const LongTask&)>;
+
+  // Lower bounds of the buckets of histogram(), in milliseconds.
+  static constexpr std::array<int, 9> kBucketBounds = {
+      0, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+  // |callback| is run on the UI thread after each long task.
+  JankDetector(v8::Isolate* isolate, const Options& options, Callback callback);
+  ~JankDetector() override;
+
+  // disable copy
+  JankDetector(const JankDetector&) = delete;
+  JankDetector& operator=(const JankDetector&) = delete;
+
+  // The number of long tasks per bucket of kBucketBounds.
+  const std::array<int, kBucketBounds.size()>& histogram() const {
+    return histogram_;
+  }
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  class State;
+  class Watchdog;
+
+  struct RunningTask {
+    base::TimeTicks start_time;
+    std::string attribution;
+    // Whether a nested run loop ran other tasks meanwhile, in which case the
+    // thread wasn't stuck.
+    bool nested = false;
+  };
+
+  void Report(const LongTask& task);
+
+  const Options options_;
+  Callback callback_;
+  scoped_refptr<State> state_;
+  base::SequenceBound<Watchdog> watchdog_;
+
+  // Innermost last.
+  std::vector<RunningTask> running_tasks_;
+  std::array<int, kBucketBounds.size()> histogram_ = {};
+
+  base::WeakPtrFactory<JankDetector> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_JANK_DETECTOR_H_
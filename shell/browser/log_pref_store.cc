@@ -0,0 +1,376 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/log_pref_store.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/functional/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_split.h"
+#include "base/task/thread_pool.h"
+#include "base/timer/elapsed_timer.h"
+
+namespace electron {
+
+namespace {
+
+// Changes made within this delay are written together.
+constexpr base::TimeDelta kFlushDelay = base::Seconds(1);
+
+// The log is compacted once it's larger than the snapshot, but never while
+// it's smaller than this.
+constexpr int64_t kMinCompactionSize = 64 * 1024;
+
+// Each line of the log is a record of a changed pref, without "value" when
+// the pref was removed.
+constexpr std::string_view kKeyKey = "key";
+constexpr std::string_view kValueKey = "value";
+
+base::FilePath GetLogPath(const base::FilePath& path) {
+  return path.AddExtension(FILE_PATH_LITERAL("log"));
+}
+
+// Reads the snapshot at |path| and replays its log over it.
+PersistentPrefStore::PrefReadError ReadSnapshotAndLog(
+    const base::FilePath& path,
+    base::Value::Dict* prefs,
+    int64_t* snapshot_size,
+    int64_t* log_size) {
+  auto error = PersistentPrefStore::PREF_READ_ERROR_NONE;
+  std::string snapshot;
+  if (base::ReadFileToString(path, &snapshot)) {
+    *snapshot_size = snapshot.size();
+    if (std::optional<base::Value::Dict> dict =
+            base::JSONReader::ReadDict(snapshot)) {
+      *prefs = std::move(*dict);
+    } else {
+      error = PersistentPrefStore::PREF_READ_ERROR_JSON_PARSE;
+    }
+  } else {
+    error = base::PathExists(path)
+                ? PersistentPrefStore::PREF_READ_ERROR_FILE_OTHER
+                : PersistentPrefStore::PREF_READ_ERROR_NO_FILE;
+  }
+
+  std::string log;
+  if (!base::ReadFileToString(GetLogPath(path), &log))
+    return error;
+  *log_size = log.size();
+  for (std::string_view line : base::SplitStringPiece(
+           log, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::optional<base::Value::Dict> record = base::JSONReader::ReadDict(line);
+    // Records are cut short when the app dies while appending them.
+    const std::string* key = record ? record->FindString(kKeyKey) : nullptr;
+    if (!key)
+      continue;
+    if (base::Value* value = record->Find(kValueKey))
+      prefs->SetByDottedPath(*key, std::move(*value));
+    else
+      prefs->RemoveByDottedPath(*key);
+  }
+  return error;
+}
+
+}  // namespace
+
+// Owns the files of the store on a background sequence.
+class LogPrefStore::Writer {
+ public:
+  explicit Writer(const base::FilePath& path)
+      : path_(path), log_path_(GetLogPath(path)) {}
+
+  // disable copy
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  WriteResult Append(std::string records) {
+    base::ElapsedTimer timer;
+    if (!log_.IsValid()) {
+      log_.Initialize(log_path_, base::File::FLAG_OPEN_ALWAYS |
+                                     base::File::FLAG_READ |
+                                     base::File::FLAG_APPEND);
+      // Don't glue the first record to one that was cut short.
+      const int64_t length = log_.GetLength();
+      uint8_t last = '\n';
+      if (length > 0 && log_.Read(length - 1, base::span_from_ref(last)) &&
+          last != '\n') {
+        records.insert(records.begin(), '\n');
+      }
+    }
+    WriteResult result;
+    if (log_.IsValid() &&
+        log_.WriteAtCurrentPosAndCheck(base::as_byte_span(records))) {
+      result.bytes = records.size();
+    }
+    result.duration = timer.Elapsed();
+    return result;
+  }
+
+  WriteResult Compact(base::Value::Dict prefs) {
+    base::ElapsedTimer timer;
+    WriteResult result;
+    result.compacted = true;
+    std::optional<std::string> snapshot = base::WriteJson(prefs);
+    if (snapshot &&
+        base::ImportantFileWriter::WriteFileAtomically(path_, *snapshot)) {
+      result.bytes = snapshot->size();
+      // The log is only dropped once the snapshot has every change. Replaying
+      // it over the new snapshot is harmless, so dying in between is fine.
+      log_.Close();
+      base::DeleteFile(log_path_);
+    }
+    result.duration = timer.Elapsed();
+    return result;
+  }
+
+  // Replies once the writes posted before are done.
+  void Sync() {}
+
+  void RunCallback(base::OnceClosure callback) { std::move(callback).Run(); }
+
+ private:
+  const base::FilePath path_;
+  const base::FilePath log_path_;
+  base::File log_;
+};
+
+LogPrefStore::LogPrefStore(const base::FilePath& path)
+    : path_(path),
+      writer_(base::ThreadPool::CreateSequencedTaskRunner(
+                  {base::MayBlock(),
+                   base::TaskShutdownBehavior::BLOCK_SHUTDOWN}),
+              path) {}
+
+LogPrefStore::~LogPrefStore() {
+  // Like JsonPrefStore, only lossy changes are dropped.
+  if (flush_timer_.IsRunning())
+    Flush(base::OnceClosure());
+}
+
+// static
+void LogPrefStore::MergeLogIntoSnapshot(const base::FilePath& path) {
+  const base::FilePath log_path = GetLogPath(path);
+  if (!base::PathExists(log_path))
+    return;
+  base::Value::Dict prefs;
+  int64_t snapshot_size = 0;
+  int64_t log_size = 0;
+  ReadSnapshotAndLog(path, &prefs, &snapshot_size, &log_size);
+  std::optional<std::string> snapshot = base::WriteJson(prefs);
+  if (snapshot &&
+      base::ImportantFileWriter::WriteFileAtomically(path, *snapshot)) {
+    base::DeleteFile(log_path);
+  }
+}
+
+LogPrefStore::Metrics LogPrefStore::metrics() const {
+  Metrics metrics = metrics_;
+  metrics.log_size = log_size_;
+  return metrics;
+}
+
+void LogPrefStore::AddObserver(PrefStore::Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void LogPrefStore::RemoveObserver(PrefStore::Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+bool LogPrefStore::HasObservers() const {
+  return !observers_.empty();
+}
+
+bool LogPrefStore::IsInitializationComplete() const {
+  return initialized_;
+}
+
+bool LogPrefStore::GetValue(std::string_view key,
+                            const base::Value** result) const {
+  const base::Value* value = prefs_.FindByDottedPath(key);
+  if (!value)
+    return false;
+  if (result)
+    *result = value;
+  return true;
+}
+
+base::Value::Dict LogPrefStore::GetValues() const {
+  return prefs_.Clone();
+}
+
+void LogPrefStore::SetValue(std::string_view key,
+                            base::Value value,
+                            uint32_t flags) {
+  const base::Value* old_value = prefs_.FindByDottedPath(key);
+  if (old_value && *old_value == value)
+    return;
+  prefs_.SetByDottedPath(key, std::move(value));
+  ReportValueChanged(key, flags);
+}
+
+bool LogPrefStore::GetMutableValue(std::string_view key,
+                                   base::Value** result) {
+  base::Value* value = prefs_.FindByDottedPath(key);
+  if (!value)
+    return false;
+  if (result)
+    *result = value;
+  return true;
+}
+
+void LogPrefStore::ReportValueChanged(std::string_view key, uint32_t flags) {
+  for (PrefStore::Observer& observer : observers_)
+    observer.OnPrefValueChanged(key);
+  ScheduleWrite(key, flags);
+}
+
+void LogPrefStore::SetValueSilently(std::string_view key,
+                                    base::Value value,
+                                    uint32_t flags) {
+  const base::Value* old_value = prefs_.FindByDottedPath(key);
+  if (old_value && *old_value == value)
+    return;
+  prefs_.SetByDottedPath(key, std::move(value));
+  ScheduleWrite(key, flags);
+}
+
+void LogPrefStore::RemoveValue(std::string_view key, uint32_t flags) {
+  if (prefs_.RemoveByDottedPath(key))
+    ReportValueChanged(key, flags);
+}
+
+void LogPrefStore::RemoveValuesByPrefixSilently(std::string_view prefix) {
+  if (prefs_.RemoveByDottedPath(prefix))
+    ScheduleWrite(prefix, DEFAULT_PREF_WRITE_FLAGS);
+}
+
+bool LogPrefStore::ReadOnly() const {
+  return false;
+}
+
+PersistentPrefStore::PrefReadError LogPrefStore::GetReadError() const {
+  return read_error_;
+}
+
+PersistentPrefStore::PrefReadError LogPrefStore::ReadPrefs() {
+  read_error_ =
+      ReadSnapshotAndLog(path_, &prefs_, &snapshot_size_, &log_size_);
+  initialized_ = true;
+  for (PrefStore::Observer& observer : observers_)
+    observer.OnInitializationCompleted(true);
+  return read_error_;
+}
+
+void LogPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
+  error_delegate_.reset(error_delegate);
+  ReadPrefs();
+  if (error_delegate_ && read_error_ != PREF_READ_ERROR_NONE &&
+      read_error_ != PREF_READ_ERROR_NO_FILE) {
+    error_delegate_->OnError(read_error_);
+  }
+}
+
+void LogPrefStore::CommitPendingWrite(
+    base::OnceClosure reply_callback,
+    base::OnceClosure synchronous_done_callback) {
+  Flush(std::move(reply_callback));
+  if (synchronous_done_callback) {
+    writer_.AsyncCall(&Writer::RunCallback)
+        .WithArgs(std::move(synchronous_done_callback));
+  }
+}
+
+void LogPrefStore::SchedulePendingLossyWrites() {
+  if (!pending_keys_.empty())
+    ScheduleFlush();
+}
+
+void LogPrefStore::OnStoreDeletionFromDisk() {
+  pending_keys_.clear();
+  flush_timer_.Stop();
+}
+
+bool LogPrefStore::HasReadErrorDelegate() const {
+  return error_delegate_ != nullptr;
+}
+
+void LogPrefStore::ScheduleWrite(std::string_view key, uint32_t flags) {
+  pending_keys_.emplace(key);
+  if (!(flags & LOSSY_PREF_WRITE_FLAG))
+    ScheduleFlush();
+}
+
+void LogPrefStore::ScheduleFlush() {
+  if (flush_timer_.IsRunning())
+    return;
+  flush_timer_.Start(FROM_HERE, kFlushDelay,
+                     base::BindOnce(&LogPrefStore::Flush, base::Unretained(this),
+                                    base::OnceClosure()));
+}
+
+void LogPrefStore::Flush(base::OnceClosure reply_callback) {
+  flush_timer_.Stop();
+  if (pending_keys_.empty()) {
+    if (reply_callback)
+      writer_.AsyncCall(&Writer::Sync).Then(std::move(reply_callback));
+    return;
+  }
+
+  // Only the changed prefs are serialized here, the whole prefs are only
+  // serialized on the writer's sequence.
+  std::string records;
+  for (const std::string& key : pending_keys_) {
+    base::Value::Dict record;
+    record.Set(kKeyKey, key);
+    if (const base::Value* value = prefs_.FindByDottedPath(key))
+      record.Set(kValueKey, value->Clone());
+    if (std::optional<std::string> json = base::WriteJson(record))
+      base::StrAppend(&records, {*json, "\n"});
+  }
+  pending_keys_.clear();
+
+  auto on_written =
+      base::BindOnce(&LogPrefStore::OnWritten, weak_factory_.GetWeakPtr(),
+                     std::move(reply_callback));
+  log_size_ += records.size();
+  if (log_size_ > std::max(kMinCompactionSize, snapshot_size_)) {
+    log_size_ = 0;
+    writer_.AsyncCall(&Writer::Compact)
+        .WithArgs(prefs_.Clone())
+        .Then(std::move(on_written));
+  } else {
+    writer_.AsyncCall(&Writer::Append)
+        .WithArgs(std::move(records))
+        .Then(std::move(on_written));
+  }
+}
+
+void LogPrefStore::OnWritten(base::OnceClosure reply_callback,
+                             const WriteResult& result) {
+  if (result.compacted) {
+    ++metrics_.compaction_count;
+    metrics_.compaction_bytes += result.bytes;
+    metrics_.compaction_time += result.duration;
+    if (result.bytes > 0)
+      snapshot_size_ = result.bytes;
+  } else {
+    ++metrics_.write_count;
+    metrics_.write_bytes += result.bytes;
+    metrics_.write_time += result.duration;
+  }
+  if (reply_callback)
+    std::move(reply_callback).Run();
+}
+
+}  // namespace electron
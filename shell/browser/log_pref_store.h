@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_LOG_PREF_STORE_H_
+#define ELECTRON_SHELL_BROWSER_LOG_PREF_STORE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/observer_list.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
+#include "components/prefs/persistent_pref_store.h"
+
+namespace electron {
+
+// A PersistentPrefStore that keeps a snapshot of the prefs at |path|, in the
+// same format as JsonPrefStore, and appends the changed prefs to a log next to
+// it instead of rewriting the whole snapshot on every change. Changes are
+// batched, and the log is folded back into the snapshot once it grows larger
+// than the snapshot. Files are only read and written on a background
+// sequence, except by ReadPrefs().
+class LogPrefStore : public PersistentPrefStore {
+ public:
+  struct Metrics {
+    // Batches of changes appended to the log.
+    int write_count = 0;
+    int64_t write_bytes = 0;
+    base::TimeDelta write_time;
+    // Rewrites of the snapshot.
+    int compaction_count = 0;
+    int64_t compaction_bytes = 0;
+    base::TimeDelta compaction_time;
+    // The size of the log once the pending writes are done.
+    int64_t log_size = 0;
+  };
+
+  explicit LogPrefStore(const base::FilePath& path);
+
+  // disable copy
+  LogPrefStore(const LogPrefStore&) = delete;
+  LogPrefStore& operator=(const LogPrefStore&) = delete;
+
+  // Folds the log left next to |path| by a LogPrefStore into the snapshot, so
+  // that a JsonPrefStore reading |path| sees every change. Blocks.
+  static void MergeLogIntoSnapshot(const base::FilePath& path);
+
+  Metrics metrics() const;
+
+  // PrefStore:
+  void AddObserver(PrefStore::Observer* observer) override;
+  void RemoveObserver(PrefStore::Observer* observer) override;
+  bool HasObservers() const override;
+  bool IsInitializationComplete() const override;
+  bool GetValue(std::string_view key,
+                const base::Value** result) const override;
+  base::Value::Dict GetValues() const override;
+
+  // WriteablePrefStore:
+  void SetValue(std::string_view key,
+                base::Value value,
+                uint32_t flags) override;
+  bool GetMutableValue(std::string_view key, base::Value** result) override;
+  void ReportValueChanged(std::string_view key, uint32_t flags) override;
+  void SetValueSilently(std::string_view key,
+                        base::Value value,
+                        uint32_t flags) override;
+  void RemoveValue(std::string_view key, uint32_t flags) override;
+  void RemoveValuesByPrefixSilently(std::string_view prefix) override;
+
+  // PersistentPrefStore:
+  bool ReadOnly() const override;
+  PrefReadError GetReadError() const override;
+  PrefReadError ReadPrefs() override;
+  void ReadPrefsAsync(ReadErrorDelegate* error_delegate) override;
+  void CommitPendingWrite(base::OnceClosure reply_callback,
+                          base::OnceClosure synchronous_done_callback) override;
+  void SchedulePendingLossyWrites() override;
+  void OnStoreDeletionFromDisk() override;
+  bool HasReadErrorDelegate() const override;
+
+ private:
+  class Writer;
+
+  struct WriteResult {
+    bool compacted = false;
+    int64_t bytes = 0;
+    base::TimeDelta duration;
+  };
+
+  ~LogPrefStore() override;
+
+  // Remembers that |key| changed, and schedules a write unless the change
+  // is lossy.
+  void ScheduleWrite(std::string_view key, uint32_t flags);
+  void ScheduleFlush();
+
+  // Writes the pending changes, either by appending them to the log or by
+  // compacting the log into the snapshot.
+  void Flush(base::OnceClosure reply_callback);
+
+  void OnWritten(base::OnceClosure reply_callback, const WriteResult& result);
+
+  const base::FilePath path_;
+  base::Value::Dict prefs_;
+  bool initialized_ = false;
+  PrefReadError read_error_ = PREF_READ_ERROR_NONE;
+  std::unique_ptr<ReadErrorDelegate> error_delegate_;
+
+  // Sorted, so that a pref is logged before the prefs nested in it.
+  std::set<std::string, std::less<>> pending_keys_;
+  base::OneShotTimer flush_timer_;
+  base::SequenceBound<Writer> writer_;
+
+  int64_t snapshot_size_ = 0;
+  int64_t log_size_ = 0;
+  Metrics metrics_;
+
+  base::ObserverList<PrefStore::Observer, true>::Unchecked observers_;
+
+  base::WeakPtrFactory<LogPrefStore> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_LOG_PREF_STORE_H_
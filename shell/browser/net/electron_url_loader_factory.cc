@@ -5,12 +5,19 @@
 #include "shell/browser/net/electron_url_loader_factory.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/containers/fixed_flat_map.h"
+#include "base/files/file_util.h"
+#include "base/strings/escape.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/thread_pool.h"
 #include "base/uuid.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
@@ -20,6 +27,7 @@
 #include "net/http/http_request_headers.h"
 #include "net/http/http_status_code.h"
 #include "net/url_request/redirect_util.h"
+#include "services/network/public/cpp/resource_request_body.h"
 #include "services/network/public/cpp/url_loader_completion_status.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/electron_api_session.h"
@@ -27,6 +35,8 @@
 #include "shell/browser/net/asar/asar_url_loader.h"
 #include "shell/browser/net/node_stream_loader.h"
 #include "shell/browser/net/url_pipe_loader.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -179,6 +189,185 @@ void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
   write_data->client->OnComplete(status);
 }
 
+// Returns the body of a buffer or string response, which are the responses
+// that can be cached.
+std::optional<std::string> GetBufferedBody(v8::Isolate* isolate,
+                                           ProtocolType type,
+                                           v8::Local<v8::Value> response,
+                                           const gin_helper::Dictionary& dict) {
+  v8::Local<v8::Value> data = response;
+  if (!dict.IsEmpty() && dict.Has("data"))
+    dict.Get("data", &data);
+
+  if (data->IsArrayBufferView() &&
+      (type == ProtocolType::kBuffer || type == ProtocolType::kFree))
+    return std::string(node::Buffer::Data(data), node::Buffer::Length(data));
+  if (data->IsString() &&
+      (type == ProtocolType::kString || type == ProtocolType::kFree))
+    return gin::V8ToString(isolate, data);
+  return std::nullopt;
+}
+
+using MountMissCallback = base::OnceCallback<void(
+    mojo::PendingReceiver<network::mojom::URLLoader>,
+    mojo::PendingRemote<network::mojom::URLLoaderClient>)>;
+
+const DirectoryMount* FindMount(const DirectoryMountMap& mounts,
+                                const GURL& url) {
+  if (mounts.empty())
+    return nullptr;
+  auto iter = mounts.find(url.host_piece());
+  if (iter == mounts.end())
+    iter = mounts.find(std::string_view());
+  return iter != mounts.end() ? &iter->second : nullptr;
+}
+
+// Maps the path of |url| onto a file under |mount|, refusing anything that
+// would escape the mounted directory. Symbolic links are only resolved by
+// IsInsideMount() on the worker thread.
+bool ResolveMountedPath(const DirectoryMount& mount,
+                        const GURL& url,
+                        base::FilePath* out) {
+  std::string path = base::UnescapeBinaryURLComponent(url.path_piece());
+  if (path.empty() || path.back() == '/')
+    path += "index.html";
+  if (path.find('\0') != std::string::npos)
+    return false;
+
+  base::FilePath relative = base::FilePath::FromUTF8Unsafe(
+      base::TrimString(path, "/", base::TRIM_LEADING));
+  if (relative.empty() || relative.IsAbsolute() || relative.ReferencesParent())
+    return false;
+
+  *out = mount.root.Append(relative);
+  return true;
+}
+
+// Resolves the symbolic links in |path|, or in the path of the asar archive
+// containing it. Returns an empty path when it does not exist.
+base::FilePath MakeRealPath(const base::FilePath& path) {
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    base::FilePath archive = base::MakeAbsoluteFilePath(asar_path);
+    return archive.empty() ? archive : archive.Append(relative_path);
+  }
+  return base::MakeAbsoluteFilePath(path);
+}
+
+// Whether |path| is still under |root| once symbolic links are resolved, in
+// which case |real_path| is set to the resolved path.
+bool IsInsideMount(const base::FilePath& root,
+                   const base::FilePath& path,
+                   base::FilePath* real_path) {
+  const base::FilePath real_root = MakeRealPath(root);
+  *real_path = MakeRealPath(path);
+  return !real_root.empty() && real_root.IsParent(*real_path);
+}
+
+// Returns a validator for the file at |path|, or nothing when there is no
+// such file. Files inside asar archives use their integrity hash when the
+// archive has one.
+std::optional<std::string> GetMountedFileETag(const base::FilePath& path) {
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(asar_path);
+    asar::Archive::FileInfo info;
+    if (!archive || !archive->GetFileInfo(relative_path, &info))
+      return std::nullopt;
+    if (info.integrity.has_value())
+      return absl::StrFormat("\"%s\"", info.integrity->hash);
+
+    base::File::Info archive_info;
+    if (!base::GetFileInfo(asar_path, &archive_info))
+      return std::nullopt;
+    return absl::StrFormat(
+        "\"%x-%x-%x\"",
+        archive_info.last_modified.InMillisecondsSinceUnixEpoch(), info.offset,
+        info.size);
+  }
+
+  base::File::Info file_info;
+  if (!base::GetFileInfo(path, &file_info) || file_info.is_directory)
+    return std::nullopt;
+  return absl::StrFormat("\"%x-%x\"",
+                         file_info.last_modified.InMillisecondsSinceUnixEpoch(),
+                         file_info.size);
+}
+
+// Weak comparison of an If-None-Match header against |etag|.
+bool MatchesETag(std::string_view if_none_match, std::string_view etag) {
+  for (std::string_view candidate : base::SplitStringPiece(
+           if_none_match, ",", base::TRIM_WHITESPACE,
+           base::SPLIT_WANT_NONEMPTY)) {
+    if (candidate == "*")
+      return true;
+    if (base::StartsWith(candidate, "W/"))
+      candidate.remove_prefix(2);
+    if (candidate == etag)
+      return true;
+  }
+  return false;
+}
+
+// Runs on a worker thread. Serves the file at |mounted_path| under |root|, or
+// hands the request to |on_miss| when there is no such file.
+void StartLoadingMountedFile(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    network::ResourceRequest request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const base::FilePath& root,
+    const base::FilePath& mounted_path,
+    const base::StringPairs& headers,
+    MountMissCallback on_miss) {
+  // Symbolic links pointing out of the mount are treated as missing files.
+  base::FilePath path;
+  if (!IsInsideMount(root, mounted_path, &path)) {
+    std::move(on_miss).Run(std::move(loader), std::move(client));
+    return;
+  }
+
+  std::optional<std::string> etag = GetMountedFileETag(path);
+  if (!etag) {
+    std::move(on_miss).Run(std::move(loader), std::move(client));
+    return;
+  }
+
+  auto response_headers =
+      base::MakeRefCounted<net::HttpResponseHeaders>("HTTP/1.1 200 OK");
+  for (const auto& [name, value] : headers)
+    response_headers->AddHeader(name, value);
+  if (!response_headers->HasHeader("Access-Control-Allow-Origin"))
+    response_headers->AddHeader("Access-Control-Allow-Origin", "*");
+  response_headers->SetHeader("ETag", *etag);
+
+  if (auto if_none_match =
+          request.headers.GetHeader(net::HttpRequestHeaders::kIfNoneMatch);
+      if_none_match && MatchesETag(*if_none_match, *etag)) {
+    response_headers->ReplaceStatusLine("HTTP/1.1 304 Not Modified");
+    auto head = network::mojom::URLResponseHead::New();
+    head->headers = std::move(response_headers);
+
+    mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+        std::move(client));
+    mojo::ScopedDataPipeProducerHandle producer;
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK) {
+      client_remote->OnComplete(
+          network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+      return;
+    }
+    client_remote->OnReceiveResponse(std::move(head), std::move(consumer),
+                                     std::nullopt);
+    client_remote->OnComplete(network::URLLoaderCompletionStatus(net::OK));
+    return;
+  }
+
+  request.url = net::FilePathToFileURL(path);
+  asar::CreateAsarURLLoader(request, std::move(loader), std::move(client),
+                            std::move(response_headers));
+}
+
 }  // namespace
 
 ElectronURLLoaderFactory::RedirectedRequest::RedirectedRequest(
@@ -261,12 +450,15 @@ void ElectronURLLoaderFactory::RedirectedRequest::DeleteThis() {
 // static
 mojo::PendingRemote<network::mojom::URLLoaderFactory>
 ElectronURLLoaderFactory::Create(ProtocolType type,
-                                 const ProtocolHandler& handler) {
+                                 const ProtocolHandler& handler,
+                                 DirectoryMountMap mounts,
+                                 scoped_refptr<ProtocolResponseCache> cache) {
   mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote;
 
   // The ElectronURLLoaderFactory will delete itself when there are no more
   // receivers - see the SelfDeletingURLLoaderFactory::OnDisconnect method.
-  new ElectronURLLoaderFactory(type, handler,
+  new ElectronURLLoaderFactory(type, handler, std::move(mounts),
+                               std::move(cache),
                                pending_remote.InitWithNewPipeAndPassReceiver());
 
   return pending_remote;
@@ -275,10 +467,14 @@ ElectronURLLoaderFactory::Create(ProtocolType type,
 ElectronURLLoaderFactory::ElectronURLLoaderFactory(
     ProtocolType type,
     const ProtocolHandler& handler,
+    DirectoryMountMap mounts,
+    scoped_refptr<ProtocolResponseCache> cache,
     mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver)
     : network::SelfDeletingURLLoaderFactory(std::move(factory_receiver)),
       type_(type),
-      handler_(handler) {}
+      handler_(handler),
+      mounts_(std::move(mounts)),
+      cache_(std::move(cache)) {}
 
 ElectronURLLoaderFactory::~ElectronURLLoaderFactory() = default;
 
@@ -297,11 +493,153 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
   mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory;
   this->Clone(target_factory.InitWithNewPipeAndPassReceiver());
 
-  handler_.Run(
-      request,
-      base::BindOnce(&ElectronURLLoaderFactory::StartLoading, std::move(loader),
-                     request_id, options, request, std::move(client),
-                     traffic_annotation, std::move(target_factory), type_));
+  auto run_handler = base::BindOnce(
+      &ElectronURLLoaderFactory::RunHandler, handler_, cache_, type_,
+      request_id, options, request, traffic_annotation,
+      std::move(target_factory));
+
+  // Files in mounted directories are looked up and served on a worker thread,
+  // only misses come back here to run the JS handler.
+  base::FilePath path;
+  if (const DirectoryMount* mount = FindMount(mounts_, request.url);
+      mount && ResolveMountedPath(*mount, request.url, &path)) {
+    base::ThreadPool::PostTask(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&StartLoadingMountedFile, std::move(loader), request,
+                       std::move(client), mount->root, path, mount->headers,
+                       base::BindPostTask(content::GetUIThreadTaskRunner({}),
+                                          std::move(run_handler))));
+    return;
+  }
+
+  std::move(run_handler).Run(std::move(loader), std::move(client));
+}
+
+// static
+void ElectronURLLoaderFactory::RunHandler(
+    const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> cache,
+    ProtocolType type,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
+  // Schemes that only have directory mounts have no handler to fall back to.
+  if (handler.is_null()) {
+    OnComplete(std::move(client), request_id,
+               network::URLLoaderCompletionStatus(net::ERR_FILE_NOT_FOUND));
+    return;
+  }
+
+  if (!cache) {
+    handler.Run(request,
+                base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
+                               std::move(loader), request_id, options, request,
+                               std::move(client), traffic_annotation,
+                               std::move(target_factory), type));
+    return;
+  }
+
+  const ProtocolResponseCache::Entry* entry = nullptr;
+  std::string etag;
+  switch (cache->Lookup(request, &entry)) {
+    case ProtocolResponseCache::LookupResult::kFresh:
+      SendCachedResponse(std::move(client), *entry);
+      return;
+    case ProtocolResponseCache::LookupResult::kStale:
+      etag = entry->head->headers->GetNormalizedHeader("etag").value_or(
+          std::string());
+      break;
+    case ProtocolResponseCache::LookupResult::kMiss:
+      break;
+  }
+
+  RunHandlerWithCache(handler, std::move(cache), etag, type, request_id,
+                      options, request, traffic_annotation,
+                      std::move(target_factory), std::move(loader),
+                      std::move(client));
+}
+
+// static
+void ElectronURLLoaderFactory::RunHandlerWithCache(
+    const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> cache,
+    const std::string& etag,
+    ProtocolType type,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
+  network::ResourceRequest handler_request = request;
+  // Let the handler confirm the stale cached entry with a 304.
+  if (!etag.empty()) {
+    handler_request.headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch,
+                                      etag);
+  }
+
+  handler.Run(handler_request,
+              base::BindOnce(&ElectronURLLoaderFactory::StartLoadingWithCache,
+                             handler, std::move(cache), etag,
+                             base::Time::Now(), std::move(loader), request_id,
+                             options, request, std::move(client),
+                             traffic_annotation, std::move(target_factory),
+                             type));
+}
+
+// static
+void ElectronURLLoaderFactory::StartLoadingWithCache(
+    const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> cache,
+    const std::string& etag,
+    base::Time request_time,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+    ProtocolType type,
+    gin::Arguments* args) {
+  // Only peek at the response, |StartLoading| still consumes it.
+  if (v8::Local<v8::Value> response = args->PeekNext(); !response.IsEmpty()) {
+    gin_helper::Dictionary dict = ToDict(args->isolate(), response);
+    network::mojom::URLResponseHeadPtr head = ToResponseHead(dict);
+    const bool not_modified =
+        head->headers->response_code() == net::HTTP_NOT_MODIFIED;
+    if (not_modified && !etag.empty()) {
+      if (const auto* entry =
+              cache->Revalidated(request, etag, request_time, *head)) {
+        SendCachedResponse(std::move(client), *entry);
+        return;
+      }
+      // The 304 doesn't confirm the cached entry, and the client never asked
+      // for one, so ask the handler again for the full response.
+      RunHandlerWithCache(handler, std::move(cache), std::string(), type,
+                          request_id, options, request, traffic_annotation,
+                          std::move(target_factory), std::move(loader),
+                          std::move(client));
+      return;
+    }
+    if (!not_modified) {
+      if (std::optional<std::string> body =
+              GetBufferedBody(args->isolate(), type, response, dict)) {
+        cache->Store(request, request_time, *head, std::move(*body));
+      }
+    }
+  }
+
+  StartLoading(std::move(loader), request_id, options, request,
+               std::move(client), traffic_annotation, std::move(target_factory),
+               type, args);
 }
 
 // static
@@ -441,8 +779,8 @@ void ElectronURLLoaderFactory::StartLoading(
     }
     case ProtocolType::kHttp:
       if (GURL url; !dict.IsEmpty() && dict.Get("url", &url) && url.is_valid())
-        StartLoadingHttp(std::move(client), std::move(loader), request,
-                         traffic_annotation, dict);
+        StartLoadingHttp(std::move(client), std::move(loader), request_id,
+                         options, request, traffic_annotation, dict);
       else
         OnComplete(std::move(client), request_id,
                    network::URLLoaderCompletionStatus(net::ERR_FAILED));
@@ -474,8 +812,8 @@ void ElectronURLLoaderFactory::StartLoading(
         // |data| wasn't specified, so look for |response.url| or
         // |response.path|.
         if (GURL url; dict.Get("url", &url))
-          StartLoadingHttp(std::move(client), std::move(loader), request,
-                           traffic_annotation, dict);
+          StartLoadingHttp(std::move(client), std::move(loader), request_id,
+                           options, request, traffic_annotation, dict);
         else if (base::FilePath path; dict.Get("path", &path))
           StartLoadingFile(std::move(client), std::move(loader),
                            std::move(head), request, path, dict);
@@ -527,6 +865,8 @@ void ElectronURLLoaderFactory::StartLoadingFile(
 void ElectronURLLoaderFactory::StartLoadingHttp(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t request_id,
+    uint32_t options,
     const network::ResourceRequest& original_request,
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
     const gin_helper::Dictionary& dict) {
@@ -560,6 +900,30 @@ void ElectronURLLoaderFactory::StartLoadingHttp(
     }
   }
 
+  // Hand the client straight to a loader of the network service, so that the
+  // body and any redirects flow to the requester without being relayed
+  // through this thread.
+  if (bool passthrough = false;
+      dict.Get("passthrough", &passthrough) && passthrough) {
+    request->priority = original_request.priority;
+    request->resource_type = original_request.resource_type;
+    request->destination = original_request.destination;
+    const std::string* content_type = upload_data.FindString("contentType");
+    const std::string* data = upload_data.FindString("data");
+    if (content_type && data) {
+      request->request_body =
+          base::MakeRefCounted<network::ResourceRequestBody>();
+      request->request_body->AppendBytes(
+          std::vector<uint8_t>(data->begin(), data->end()));
+      request->headers.SetHeader(net::HttpRequestHeaders::kContentType,
+                                 *content_type);
+    }
+    browser_context->GetURLLoaderFactory()->CreateLoaderAndStart(
+        std::move(loader), request_id, options, *request, std::move(client),
+        traffic_annotation);
+    return;
+  }
+
   new URLPipeLoader(
       browser_context->GetURLLoaderFactory(), std::move(request),
       std::move(loader), std::move(client),
@@ -620,6 +984,18 @@ void ElectronURLLoaderFactory::StartLoadingStream(
                        data.isolate(), data.GetHandle());
 }
 
+// static
+void ElectronURLLoaderFactory::SendCachedResponse(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const ProtocolResponseCache::Entry& entry) {
+  // The cached headers must stay untouched by |SendContents|.
+  network::mojom::URLResponseHeadPtr head = entry.head.Clone();
+  head->headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+      entry.head->headers->raw_headers());
+  head->was_fetched_via_cache = true;
+  SendContents(std::move(client), std::move(head), entry.body);
+}
+
 // static
 void ElectronURLLoaderFactory::SendContents(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
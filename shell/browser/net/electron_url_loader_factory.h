@@ -11,6 +11,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_split.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -20,6 +24,7 @@
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom-forward.h"
+#include "shell/browser/net/protocol_response_cache.h"
 #include "v8/include/v8-array-buffer.h"
 
 namespace gin {
@@ -56,6 +61,17 @@ using ProtocolHandler =
 using HandlersMap = std::
     map<std::string, std::pair<ProtocolType, ProtocolHandler>, std::less<>>;
 
+// A directory, or a directory inside an asar archive, whose files are served
+// without entering JS.
+struct DirectoryMount {
+  base::FilePath root;
+  // Headers added to every response served from |root|.
+  base::StringPairs headers;
+};
+
+// host => mount, the empty host matches requests to any host.
+using DirectoryMountMap = std::map<std::string, DirectoryMount, std::less<>>;
+
 // Implementation of URLLoaderFactory.
 class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
  public:
@@ -105,9 +121,14 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
     mojo::Remote<network::mojom::URLLoaderFactory> target_factory_remote_;
   };
 
+  // Requests hitting a file in |mounts| are served on a worker thread, all
+  // others are passed to |handler|, which may be null. When |cache| is given
+  // the responses of |handler| are cached in it.
   static mojo::PendingRemote<network::mojom::URLLoaderFactory> Create(
       ProtocolType type,
-      const ProtocolHandler& handler);
+      const ProtocolHandler& handler,
+      DirectoryMountMap mounts = {},
+      scoped_refptr<ProtocolResponseCache> cache = nullptr);
 
   // network::mojom::URLLoaderFactory:
   void CreateLoaderAndStart(
@@ -138,14 +159,63 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
   ElectronURLLoaderFactory(
       ProtocolType type,
       const ProtocolHandler& handler,
+      DirectoryMountMap mounts,
+      scoped_refptr<ProtocolResponseCache> cache,
       mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver);
   ~ElectronURLLoaderFactory() override;
 
+  static void RunHandler(
+      const ProtocolHandler& handler,
+      scoped_refptr<ProtocolResponseCache> cache,
+      ProtocolType type,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+
   static void OnComplete(
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       int32_t request_id,
       const network::URLLoaderCompletionStatus& status);
 
+  // Runs |handler| for a request that |cache| can't answer by itself. A
+  // non-empty |etag| asks the handler to revalidate the stale entry with it.
+  static void RunHandlerWithCache(
+      const ProtocolHandler& handler,
+      scoped_refptr<ProtocolResponseCache> cache,
+      const std::string& etag,
+      ProtocolType type,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+
+  // Caches the handler's response on the way to |StartLoading|, or answers
+  // from the cache when the handler confirmed a stale entry with 304.
+  static void StartLoadingWithCache(
+      const ProtocolHandler& handler,
+      scoped_refptr<ProtocolResponseCache> cache,
+      const std::string& etag,
+      base::Time request_time,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
+      ProtocolType type,
+      gin::Arguments* args);
+  static void SendCachedResponse(
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const ProtocolResponseCache::Entry& entry);
+
   static void StartLoadingBuffer(
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
@@ -160,6 +230,8 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
   static void StartLoadingHttp(
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t request_id,
+      uint32_t options,
       const network::ResourceRequest& original_request,
       const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
       const gin_helper::Dictionary& dict);
@@ -177,6 +249,8 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
 
   ProtocolType type_;
   ProtocolHandler handler_;
+  DirectoryMountMap mounts_;
+  scoped_refptr<ProtocolResponseCache> cache_;
 };
 
 }  // namespace electron
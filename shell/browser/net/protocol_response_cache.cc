@@ -0,0 +1,241 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/protocol_response_cache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/resource_request.h"
+
+namespace electron {
+
+namespace {
+
+// Returns the sorted, lower case names of the headers named by the Vary
+// header of |headers|, or nothing when the response varies on everything.
+std::optional<std::vector<std::string>> GetVaryNames(
+    const net::HttpResponseHeaders& headers) {
+  std::vector<std::string> names;
+  size_t iter = 0;
+  while (std::optional<std::string_view> name =
+             headers.EnumerateHeader(&iter, "vary")) {
+    if (*name == "*")
+      return std::nullopt;
+    names.push_back(base::ToLowerASCII(*name));
+  }
+  std::ranges::sort(names);
+  auto duplicates = std::ranges::unique(names);
+  names.erase(duplicates.begin(), duplicates.end());
+  return names;
+}
+
+// The key of the variant of |request|'s URL selected by the values |request|
+// has for |vary_names|.
+std::string GetKey(const network::ResourceRequest& request,
+                   const std::vector<std::string>& vary_names) {
+  std::string key = request.url.spec();
+  for (const std::string& name : vary_names) {
+    base::StrAppend(&key,
+                    {"\n", name, ":",
+                     request.headers.GetHeader(name).value_or(std::string())});
+  }
+  return key;
+}
+
+size_t GetEntrySize(const ProtocolResponseCache::Entry& entry) {
+  return entry.body.size() + entry.head->headers->raw_headers().size();
+}
+
+}  // namespace
+
+ProtocolResponseCache::Entry::Entry() = default;
+ProtocolResponseCache::Entry::Entry(Entry&&) = default;
+ProtocolResponseCache::Entry& ProtocolResponseCache::Entry::operator=(
+    Entry&&) = default;
+ProtocolResponseCache::Entry::~Entry() = default;
+
+ProtocolResponseCache::Variants::Variants() = default;
+ProtocolResponseCache::Variants::Variants(Variants&&) = default;
+ProtocolResponseCache::Variants& ProtocolResponseCache::Variants::operator=(
+    Variants&&) = default;
+ProtocolResponseCache::Variants::~Variants() = default;
+
+ProtocolResponseCache::ProtocolResponseCache(size_t max_size)
+    : max_size_(max_size) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() = default;
+
+ProtocolResponseCache::LookupResult ProtocolResponseCache::Lookup(
+    const network::ResourceRequest& request,
+    const Entry** entry) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  *entry = nullptr;
+
+  // A hard reload skips the cache entirely.
+  if (request.method != net::HttpRequestHeaders::kGetMethod ||
+      request.load_flags & net::LOAD_BYPASS_CACHE) {
+    ++misses_;
+    return LookupResult::kMiss;
+  }
+
+  auto iter = Find(request);
+  if (iter == entries_.end()) {
+    ++misses_;
+    return LookupResult::kMiss;
+  }
+
+  const Entry& cached = iter->second;
+  const net::HttpResponseHeaders& headers = *cached.head->headers;
+  // A normal reload asks for the cached entries to be revalidated.
+  if (!(request.load_flags & net::LOAD_VALIDATE_CACHE) &&
+      headers.RequiresValidation(cached.request_time, cached.response_time,
+                                 base::Time::Now()) == net::VALIDATION_NONE) {
+    ++hits_;
+    *entry = &cached;
+    return LookupResult::kFresh;
+  }
+
+  ++misses_;
+  if (!headers.HasHeader("etag"))
+    return LookupResult::kMiss;
+  *entry = &cached;
+  return LookupResult::kStale;
+}
+
+bool ProtocolResponseCache::Store(const network::ResourceRequest& request,
+                                  base::Time request_time,
+                                  const network::mojom::URLResponseHead& head,
+                                  std::string body) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const net::HttpResponseHeaders* headers = head.headers.get();
+  if (request.method != net::HttpRequestHeaders::kGetMethod || !headers ||
+      headers->response_code() != net::HTTP_OK ||
+      headers->HasHeaderValue("cache-control", "no-store"))
+    return false;
+
+  // Responses that are stale right away are only worth keeping when they
+  // can be revalidated.
+  const base::Time now = base::Time::Now();
+  if (!headers->HasHeader("etag") &&
+      headers->RequiresValidation(request_time, now, now) !=
+          net::VALIDATION_NONE)
+    return false;
+
+  std::optional<std::vector<std::string>> vary_names = GetVaryNames(*headers);
+  if (!vary_names)
+    return false;
+
+  Entry entry;
+  entry.url = request.url.spec();
+  entry.head = head.Clone();
+  // The headers are shared with |head|, which is still going to be modified
+  // on its way to the client.
+  entry.head->headers =
+      base::MakeRefCounted<net::HttpResponseHeaders>(headers->raw_headers());
+  entry.body = std::move(body);
+  entry.request_time = request_time;
+  entry.response_time = now;
+
+  const size_t entry_size = GetEntrySize(entry);
+  if (entry_size > max_size_)
+    return false;
+
+  const std::string key = GetKey(request, *vary_names);
+  if (auto iter = entries_.Peek(key); iter != entries_.end())
+    Erase(iter);
+  // Lookups use the Vary of the latest response. Variants keyed by another
+  // Vary are no longer found and eventually get evicted.
+  Variants& variants = variants_[entry.url];
+  variants.vary_names = std::move(*vary_names);
+  ++variants.entry_count;
+  entries_.Put(key, std::move(entry));
+  size_ += entry_size;
+  EvictIfNeeded();
+  return true;
+}
+
+const ProtocolResponseCache::Entry* ProtocolResponseCache::Revalidated(
+    const network::ResourceRequest& request,
+    const std::string& etag,
+    base::Time request_time,
+    const network::mojom::URLResponseHead& head) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto iter = Find(request);
+  if (iter == entries_.end())
+    return nullptr;
+
+  // The entry may have been replaced while the handler ran.
+  Entry& entry = iter->second;
+  if (entry.head->headers->GetNormalizedHeader("etag") != etag)
+    return nullptr;
+  if (head.headers) {
+    std::optional<std::string> confirmed_etag =
+        head.headers->GetNormalizedHeader("etag");
+    if (confirmed_etag && *confirmed_etag != etag)
+      return nullptr;
+  }
+
+  // Per RFC 9111 the 304 refreshes the headers it carries, e.g. a new
+  // Cache-Control lifetime.
+  size_ -= GetEntrySize(entry);
+  if (head.headers)
+    entry.head->headers->Update(*head.headers);
+  entry.request_time = request_time;
+  entry.response_time = base::Time::Now();
+  size_ += GetEntrySize(entry);
+  ++revalidations_;
+  return &entry;
+}
+
+void ProtocolResponseCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  entries_.Clear();
+  variants_.clear();
+  size_ = 0;
+}
+
+ProtocolResponseCache::Stats ProtocolResponseCache::GetStats() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.revalidations = revalidations_;
+  stats.entry_count = entries_.size();
+  stats.size = size_;
+  stats.max_size = max_size_;
+  return stats;
+}
+
+ProtocolResponseCache::EntryMap::iterator ProtocolResponseCache::Find(
+    const network::ResourceRequest& request) {
+  auto variants = variants_.find(request.url.spec());
+  if (variants == variants_.end())
+    return entries_.end();
+  return entries_.Get(GetKey(request, variants->second.vary_names));
+}
+
+void ProtocolResponseCache::Erase(EntryMap::iterator iter) {
+  size_ -= GetEntrySize(iter->second);
+  auto variants = variants_.find(iter->second.url);
+  if (variants != variants_.end() && --variants->second.entry_count == 0)
+    variants_.erase(variants);
+  entries_.Erase(iter);
+}
+
+void ProtocolResponseCache::EvictIfNeeded() {
+  while (size_ > max_size_ && !entries_.empty())
+    Erase(std::prev(entries_.end()));
+}
+
+}  // namespace electron
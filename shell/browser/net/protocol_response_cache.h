@@ -0,0 +1,137 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace network {
+struct ResourceRequest;
+}  // namespace network
+
+namespace electron {
+
+// In-memory cache of the responses produced by the handler of a custom
+// protocol, so that repeated requests for the same asset don't run JS.
+//
+// Entries are keyed by URL and the values of the request headers named by the
+// response's Vary header, so that each variant of a URL gets its own entry.
+// They are kept while the response's Cache-Control allows it and revalidated
+// through their ETag once stale. Only lives on the UI thread.
+class ProtocolResponseCache : public base::RefCounted<ProtocolResponseCache> {
+ public:
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    std::string url;
+    network::mojom::URLResponseHeadPtr head;
+    std::string body;
+    base::Time request_time;
+    base::Time response_time;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t revalidations = 0;
+    size_t entry_count = 0;
+    size_t size = 0;
+    size_t max_size = 0;
+  };
+
+  enum class LookupResult {
+    kMiss,
+    // The entry can be used without asking the handler.
+    kFresh,
+    // The entry has to be revalidated with its ETag first.
+    kStale,
+  };
+
+  explicit ProtocolResponseCache(size_t max_size);
+
+  // disable copy
+  ProtocolResponseCache(const ProtocolResponseCache&) = delete;
+  ProtocolResponseCache& operator=(const ProtocolResponseCache&) = delete;
+
+  // Finds the entry matching |request|. |entry| is set for fresh entries and
+  // for stale entries that have an ETag to revalidate with.
+  LookupResult Lookup(const network::ResourceRequest& request,
+                      const Entry** entry);
+
+  // Stores the handler's response to |request| when it is cacheable. Returns
+  // whether it was stored.
+  bool Store(const network::ResourceRequest& request,
+             base::Time request_time,
+             const network::mojom::URLResponseHead& head,
+             std::string body);
+
+  // Marks the entry for |request| as fresh again after the handler answered
+  // its revalidation with |etag| with a 304. Returns the entry, or nullptr
+  // when the entry for |request| is gone or isn't the one with |etag| anymore,
+  // or when the 304 is about another ETag.
+  const Entry* Revalidated(const network::ResourceRequest& request,
+                           const std::string& etag,
+                           base::Time request_time,
+                           const network::mojom::URLResponseHead& head);
+
+  void Clear();
+
+  size_t max_size() const { return max_size_; }
+
+  Stats GetStats() const;
+
+ private:
+  friend class base::RefCounted<ProtocolResponseCache>;
+
+  using EntryMap = base::LRUCache<std::string, Entry>;
+
+  // The variants of a URL.
+  struct Variants {
+    Variants();
+    Variants(Variants&&);
+    Variants& operator=(Variants&&);
+    ~Variants();
+
+    // Lower case names of the headers named by the latest response's Vary.
+    std::vector<std::string> vary_names;
+    size_t entry_count = 0;
+  };
+
+  ~ProtocolResponseCache();
+
+  // Returns the entry matching |request|, or entries_.end().
+  EntryMap::iterator Find(const network::ResourceRequest& request);
+  void Erase(EntryMap::iterator iter);
+  void EvictIfNeeded();
+
+  const size_t max_size_;
+  size_t size_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t revalidations_ = 0;
+
+  // url and vary values => entry, most recently used first.
+  EntryMap entries_{EntryMap::NO_AUTO_EVICT};
+  std::map<std::string, Variants, std::less<>> variants_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
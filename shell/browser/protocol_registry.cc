@@ -41,8 +41,11 @@ void ProtocolRegistry::RegisterURLLoaderFactories(
   }
 
   for (const auto& it : handlers_) {
-    factories->emplace(it.first, ElectronURLLoaderFactory::Create(
-                                     it.second.first, it.second.second));
+    factories->emplace(it.first, CreateRegisteredURLLoaderFactory(it.first));
+  }
+  for (const auto& it : mounts_) {
+    if (!factories->contains(it.first))
+      factories->emplace(it.first, CreateRegisteredURLLoaderFactory(it.first));
   }
 }
 
@@ -54,11 +57,7 @@ ProtocolRegistry::CreateNonNetworkNavigationURLLoaderFactory(
       return AsarURLLoaderFactory::Create();
     }
   } else {
-    auto handler = handlers_.find(scheme);
-    if (handler != handlers_.end()) {
-      return ElectronURLLoaderFactory::Create(handler->second.first,
-                                              handler->second.second);
-    }
+    return CreateRegisteredURLLoaderFactory(scheme);
   }
   return {};
 }
@@ -97,4 +96,58 @@ const HandlersMap::mapped_type* ProtocolRegistry::FindIntercepted(
   return iter != std::end(map) ? &iter->second : nullptr;
 }
 
+bool ProtocolRegistry::MountDirectory(const std::string& scheme,
+                                      const std::string& host,
+                                      DirectoryMount mount) {
+  return mounts_[scheme].try_emplace(host, std::move(mount)).second;
+}
+
+bool ProtocolRegistry::UnmountDirectory(const std::string& scheme,
+                                        const std::string& host) {
+  const auto iter = mounts_.find(scheme);
+  if (iter == mounts_.end() || iter->second.erase(host) == 0)
+    return false;
+  if (iter->second.empty())
+    mounts_.erase(iter);
+  return true;
+}
+
+const DirectoryMountMap* ProtocolRegistry::FindMounts(
+    const std::string_view scheme) const {
+  const auto iter = mounts_.find(scheme);
+  return iter != std::end(mounts_) ? &iter->second : nullptr;
+}
+
+bool ProtocolRegistry::EnableResponseCache(const std::string& scheme,
+                                           size_t max_size) {
+  return response_caches_
+      .try_emplace(scheme,
+                   base::MakeRefCounted<ProtocolResponseCache>(max_size))
+      .second;
+}
+
+bool ProtocolRegistry::DisableResponseCache(const std::string& scheme) {
+  return response_caches_.erase(scheme) != 0;
+}
+
+ProtocolResponseCache* ProtocolRegistry::FindResponseCache(
+    const std::string_view scheme) const {
+  const auto iter = response_caches_.find(scheme);
+  return iter != std::end(response_caches_) ? iter->second.get() : nullptr;
+}
+
+mojo::PendingRemote<network::mojom::URLLoaderFactory>
+ProtocolRegistry::CreateRegisteredURLLoaderFactory(
+    const std::string_view scheme) const {
+  const auto* const handler = FindRegistered(scheme);
+  const auto* const mounts = FindMounts(scheme);
+  if (!handler && !mounts)
+    return {};
+  return ElectronURLLoaderFactory::Create(
+      handler ? handler->first : ProtocolType::kFree,
+      handler ? handler->second : ProtocolHandler(),
+      mounts ? *mounts : DirectoryMountMap(),
+      base::WrapRefCounted(FindResponseCache(scheme)));
+}
+
 }  // namespace electron
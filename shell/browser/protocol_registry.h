@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 #define ELECTRON_SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 
+#include <map>
 #include <string>
 #include <string_view>
 
@@ -51,6 +52,29 @@ class ProtocolRegistry {
   [[nodiscard]] const HandlersMap::mapped_type* FindIntercepted(
       std::string_view scheme) const;
 
+  // Requests to |host| of |scheme| that hit a file under |mount| are served
+  // natively, misses fall through to the handler registered for |scheme|.
+  bool MountDirectory(const std::string& scheme,
+                      const std::string& host,
+                      DirectoryMount mount);
+  bool UnmountDirectory(const std::string& scheme, const std::string& host);
+
+  [[nodiscard]] const DirectoryMountMap* FindMounts(
+      std::string_view scheme) const;
+
+  // Caches the responses of the handler registered for |scheme|, keeping at
+  // most |max_size| bytes.
+  bool EnableResponseCache(const std::string& scheme, size_t max_size);
+  bool DisableResponseCache(const std::string& scheme);
+
+  [[nodiscard]] ProtocolResponseCache* FindResponseCache(
+      std::string_view scheme) const;
+
+  // Returns a factory serving the handler and directory mounts of |scheme|,
+  // or an invalid remote when there is neither.
+  mojo::PendingRemote<network::mojom::URLLoaderFactory>
+  CreateRegisteredURLLoaderFactory(std::string_view scheme) const;
+
  private:
   friend class ElectronBrowserContext;
 
@@ -58,6 +82,13 @@ class ProtocolRegistry {
 
   HandlersMap handlers_;
   HandlersMap intercept_handlers_;
+
+  // scheme => mounts.
+  std::map<std::string, DirectoryMountMap, std::less<>> mounts_;
+
+  // scheme => cache.
+  std::map<std::string, scoped_refptr<ProtocolResponseCache>, std::less<>>
+      response_caches_;
 };
 
 }  // namespace electron
@@ -18,6 +18,7 @@
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/timer/timer.h"
 #include "base/uuid.h"
 #include "base/values.h"
@@ -439,6 +440,7 @@ void InspectableWebContents::ShowDevTools(bool activate) {
 void InspectableWebContents::CloseDevTools() {
   if (GetDevToolsWebContents()) {
     frontend_loaded_ = false;
+    pending_protocol_messages_.clear();
     if (managed_devtools_web_contents_) {
       view_->CloseDevTools();
       managed_devtools_web_contents_.reset();
@@ -470,6 +472,7 @@ void InspectableWebContents::Detach() {
   if (agent_host_)
     agent_host_->DetachClient(this);
   agent_host_ = nullptr;
+  pending_protocol_messages_.clear();
 }
 
 void InspectableWebContents::Reattach(DispatchCallback callback) {
@@ -487,9 +490,6 @@ void InspectableWebContents::CallClientFunction(
     base::Value arg2,
     base::Value arg3,
     base::OnceCallback<void(base::Value)> cb) {
-  if (!GetDevToolsWebContents())
-    return;
-
   base::Value::List arguments;
   if (!arg1.is_none()) {
     arguments.Append(std::move(arg1));
@@ -501,6 +501,18 @@ void InspectableWebContents::CallClientFunction(
     }
   }
 
+  CallClientFunctionWithArguments(object_name, method_name,
+                                  std::move(arguments), std::move(cb));
+}
+
+void InspectableWebContents::CallClientFunctionWithArguments(
+    std::string_view object_name,
+    std::string_view method_name,
+    base::Value::List arguments,
+    base::OnceCallback<void(base::Value)> cb) {
+  if (!GetDevToolsWebContents())
+    return;
+
   GetDevToolsWebContents()->GetPrimaryMainFrame()->ExecuteJavaScriptMethod(
       base::ASCIIToUTF16(object_name), base::ASCIIToUTF16(method_name),
       std::move(arguments), std::move(cb));
@@ -900,21 +912,55 @@ void InspectableWebContents::DispatchProtocolMessage(
     return;
 
   const std::string_view str_message = base::as_string_view(message);
-  if (str_message.length() < kMaxMessageChunkSize) {
-    CallClientFunction("DevToolsAPI", "dispatchMessage",
-                       base::Value(std::string(str_message)));
+  // Small messages go straight through unless they'd overtake the chunks of a
+  // large one that is still being delivered.
+  if (pending_protocol_messages_.empty() &&
+      str_message.length() < kMaxMessageChunkSize) {
+    CallClientFunctionWithArguments(
+        "DevToolsAPI", "dispatchMessage",
+        base::Value::List().Append(std::string(str_message)),
+        base::NullCallback());
+    return;
+  }
+
+  // The message is copied once here, its chunks are only cut out of it when
+  // they're delivered.
+  pending_protocol_messages_.push_back({std::string(str_message)});
+  if (pending_protocol_messages_.size() == 1)
+    DispatchPendingProtocolMessage();
+}
+
+void InspectableWebContents::DispatchPendingProtocolMessage() {
+  if (pending_protocol_messages_.empty())
+    return;
+
+  PendingProtocolMessage& pending = pending_protocol_messages_.front();
+  const size_t total_size = pending.message.length();
+  if (total_size < kMaxMessageChunkSize) {
+    std::string message = std::move(pending.message);
+    pending_protocol_messages_.pop_front();
+    CallClientFunctionWithArguments(
+        "DevToolsAPI", "dispatchMessage",
+        base::Value::List().Append(std::move(message)), base::NullCallback());
   } else {
-    size_t total_size = str_message.length();
-    for (size_t pos = 0; pos < str_message.length();
-         pos += kMaxMessageChunkSize) {
-      std::string_view str_message_chunk =
-          str_message.substr(pos, kMaxMessageChunkSize);
-
-      CallClientFunction(
-          "DevToolsAPI", "dispatchMessageChunk",
-          base::Value(std::string(str_message_chunk)),
-          base::Value(base::NumberToString(pos ? 0 : total_size)));
-    }
+    const size_t pos = pending.offset;
+    std::string chunk = pending.message.substr(pos, kMaxMessageChunkSize);
+    pending.offset += kMaxMessageChunkSize;
+    if (pending.offset >= total_size)
+      pending_protocol_messages_.pop_front();
+    CallClientFunctionWithArguments(
+        "DevToolsAPI", "dispatchMessageChunk",
+        base::Value::List()
+            .Append(std::move(chunk))
+            .Append(base::NumberToString(pos ? 0 : total_size)),
+        base::NullCallback());
+  }
+
+  if (!pending_protocol_messages_.empty()) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&InspectableWebContents::DispatchPendingProtocolMessage,
+                       weak_factory_.GetWeakPtr()));
   }
 }
 
@@ -8,7 +8,9 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
+#include "base/containers/circular_deque.h"
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/containers/span.h"
@@ -226,6 +228,12 @@ class InspectableWebContents
 
   void SendMessageAck(int request_id, const base::Value* arg1);
 
+  void CallClientFunctionWithArguments(std::string_view object_name,
+                                       std::string_view method_name,
+                                       base::Value::List arguments,
+                                       base::OnceCallback<void(base::Value)> cb);
+  void DispatchPendingProtocolMessage();
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   void AddDevToolsExtensionsToClient();
 #endif
@@ -254,6 +262,17 @@ class InspectableWebContents
 
   bool frontend_loaded_ = false;
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
+
+  struct PendingProtocolMessage {
+    std::string message;
+    // Where the next chunk starts, for messages split into chunks.
+    size_t offset = 0;
+  };
+
+  // Protocol messages waiting to be handed to the frontend. Large messages
+  // are split into chunks that are delivered one per task, so that a huge
+  // message (e.g. a heap snapshot) doesn't block the UI thread.
+  base::circular_deque<PendingProtocolMessage> pending_protocol_messages_;
   std::unique_ptr<content::DevToolsFrontendHost> frontend_host_;
   std::unique_ptr<DevToolsEmbedderMessageDispatcher>
       embedder_message_dispatcher_;
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -285,6 +286,25 @@ bool WebContentsPreferences::IsSandboxed() const {
   return !sandbox_disabled_by_default;
 }
 
+bool WebContentsPreferences::CanShareProcessWith(
+    const WebContentsPreferences& other) const {
+  const auto process_wide = [](const WebContentsPreferences& prefs) {
+    return std::tie(prefs.experimental_features_, prefs.node_integration_,
+                    prefs.node_integration_in_sub_frames_,
+                    prefs.node_integration_in_worker_, prefs.webview_tag_,
+                    prefs.context_isolation_, prefs.is_webview_,
+                    prefs.custom_args_, prefs.custom_switches_,
+                    prefs.enable_blink_features_,
+                    prefs.disable_blink_features_, prefs.preload_path_);
+  };
+#if BUILDFLAG(IS_MAC)
+  if (scroll_bounce_ != other.scroll_bounce_)
+    return false;
+#endif
+  return IsSandboxed() == other.IsSandboxed() &&
+         process_wide(*this) == process_wide(other);
+}
+
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     content::ChildProcessId process_id) {
@@ -80,6 +80,12 @@ class WebContentsPreferences
   std::optional<base::FilePath> GetPreloadPath() const { return preload_path_; }
   bool IsSandboxed() const;
 
+  // Whether documents of |this| and |other| can run in the same renderer
+  // process. The sandbox, Node.js and preload settings apply to the whole
+  // process and are only taken from the WebContents that launched it, so
+  // they have to match.
+  bool CanShareProcessWith(const WebContentsPreferences& other) const;
+
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
   friend class ElectronBrowserClient;
@@ -4,6 +4,7 @@
 
 #include "base/dcheck_is_on.h"
 #include "base/logging.h"
+#include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 #include "v8/include/v8.h"
@@ -40,6 +41,9 @@ void Initialize(v8::Local<v8::Object> exports,
                 void* priv) {
   gin_helper::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("log", &Log);
+  // nativeImage.isEmpty() bound without its V8 fast API call, for measuring
+  // what fast calls save.
+  dict.SetMethod("nativeImageIsEmpty", &electron::api::NativeImage::IsEmpty);
 }
 
 }  // namespace
@@ -13,8 +13,10 @@
 
 #include "base/check_op.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/functional/callback_helpers.h"
 #include "base/memory/raw_ptr.h"
 #include "base/notreached.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/sequence_checker.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
@@ -131,6 +133,9 @@ namespace electron::api {
 
 namespace {
 
+// Largest |chunkSize| accepted, net-client-request.ts checks it too.
+constexpr uint32_t kMaxChunkSize = 16 * 1024 * 1024;
+
 template <typename T>
 auto ToVec(v8::Local<v8::ArrayBufferView> view) {
   const size_t n_wanted = view->ByteLength();
@@ -332,10 +337,12 @@ gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     ElectronBrowserContext* browser_context,
     std::unique_ptr<network::ResourceRequest> request,
-    int options)
+    int options,
+    size_t chunk_size)
     : browser_context_(browser_context),
       request_options_(options),
-      request_(std::move(request)) {
+      request_(std::move(request)),
+      chunk_size_(chunk_size) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
   if (!request_->trusted_params)
     request_->trusted_params = network::ResourceRequest::TrustedParams();
@@ -510,12 +517,11 @@ SimpleURLLoaderWrapper::GetURLLoaderFactoryForURL(const GURL& url) {
                                                protocol_handler->second)));
     }
 
-    if (const auto* const protocol_handler =
-            protocol_registry->FindRegistered(scheme)) {
+    if (auto factory =
+            protocol_registry->CreateRegisteredURLLoaderFactory(scheme)) {
       return network::SharedURLLoaderFactory::Create(
           std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
-              ElectronURLLoaderFactory::Create(protocol_handler->first,
-                                               protocol_handler->second)));
+              std::move(factory)));
     }
   }
 
@@ -699,9 +705,14 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     browser_context = session->browser_context();
   }
 
+  uint32_t chunk_size = 0;
+  opts.Get("chunkSize", &chunk_size);
+  chunk_size = std::min(chunk_size, kMaxChunkSize);
+
   auto ret = gin::CreateHandle(
-      args->isolate(),
-      new SimpleURLLoaderWrapper(browser_context, std::move(request), options));
+      args->isolate(), new SimpleURLLoaderWrapper(browser_context,
+                                                  std::move(request), options,
+                                                  chunk_size));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -714,13 +725,75 @@ void SimpleURLLoaderWrapper::OnDataReceived(std::string_view string_view,
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  auto array_buffer = v8::ArrayBuffer::New(isolate, string_view.size());
-  memcpy(array_buffer->Data(), string_view.data(), string_view.size());
-  Emit("data", array_buffer, std::move(resume));
+
+  if (pending_chunk_length_ > 0 &&
+      pending_chunk_length_ + string_view.size() > chunk_size_) {
+    // Flush the buffered bytes first. |string_view| stays valid until
+    // |resume| runs, so it can be handled once JS asks for more data.
+    deferred_chunk_ = string_view;
+    deferred_resume_ = std::move(resume);
+    EmitPendingChunk(
+        base::BindOnce(&SimpleURLLoaderWrapper::OnPendingChunkConsumed,
+                       weak_factory_.GetWeakPtr()));
+    return;
+  }
+
+  if (string_view.size() >= chunk_size_) {
+    auto array_buffer = v8::ArrayBuffer::New(isolate, string_view.size());
+    memcpy(array_buffer->Data(), string_view.data(), string_view.size());
+    Emit("data", array_buffer, std::move(resume),
+         base::checked_cast<uint32_t>(string_view.size()));
+    return;
+  }
+
+  // Grow the buffer with the data received rather than allocating
+  // |chunk_size_| up front, which may be much more than the whole body.
+  const size_t needed = pending_chunk_length_ + string_view.size();
+  if (!pending_chunk_ || pending_chunk_->ByteLength() < needed) {
+    const size_t capacity = std::min(
+        chunk_size_,
+        std::max(needed, pending_chunk_ ? 2 * pending_chunk_->ByteLength()
+                                        : string_view.size()));
+    auto backing_store = v8::ArrayBuffer::NewBackingStore(isolate, capacity);
+    if (pending_chunk_length_ > 0) {
+      memcpy(backing_store->Data(), pending_chunk_->Data(),
+             pending_chunk_length_);
+    }
+    pending_chunk_ = std::move(backing_store);
+  }
+  memcpy(static_cast<char*>(pending_chunk_->Data()) + pending_chunk_length_,
+         string_view.data(), string_view.size());
+  pending_chunk_length_ += string_view.size();
+
+  if (pending_chunk_length_ == chunk_size_) {
+    EmitPendingChunk(std::move(resume));
+  } else {
+    std::move(resume).Run();
+  }
+}
+
+void SimpleURLLoaderWrapper::EmitPendingChunk(base::OnceClosure resume) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto array_buffer = v8::ArrayBuffer::New(isolate, std::move(pending_chunk_));
+  const size_t length = pending_chunk_length_;
+  pending_chunk_length_ = 0;
+  Emit("data", array_buffer, std::move(resume),
+       base::checked_cast<uint32_t>(length));
+}
+
+void SimpleURLLoaderWrapper::OnPendingChunkConsumed() {
+  OnDataReceived(std::exchange(deferred_chunk_, {}),
+                 std::move(deferred_resume_));
 }
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
   auto self = weak_factory_.GetWeakPtr();
+  if (success && pending_chunk_length_ > 0) {
+    EmitPendingChunk(base::DoNothing());
+    if (!self)
+      return;
+  }
   if (success) {
     Emit("complete");
   } else {
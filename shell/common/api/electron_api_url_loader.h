@@ -10,6 +10,7 @@
 #include <string_view>
 #include <vector>
 
+#include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
@@ -23,6 +24,7 @@
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "url/gurl.h"
+#include "v8/include/v8-array-buffer.h"
 #include "v8/include/v8-forward.h"
 
 namespace gin {
@@ -72,7 +74,8 @@ class SimpleURLLoaderWrapper final
  private:
   SimpleURLLoaderWrapper(ElectronBrowserContext* browser_context,
                          std::unique_ptr<network::ResourceRequest> request,
-                         int options);
+                         int options,
+                         size_t chunk_size);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(std::string_view string_view,
@@ -161,6 +164,17 @@ class SimpleURLLoaderWrapper final
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
+  // Network chunks smaller than |chunk_size_| are combined before being
+  // emitted to JS. They are copied into the backing store of the ArrayBuffer
+  // that is eventually emitted, which doubles in size as data arrives, so
+  // each byte is copied about twice at most. A |chunk_size_| of 0 emits every
+  // network chunk as-is.
+  size_t chunk_size_;
+  std::unique_ptr<v8::BackingStore> pending_chunk_;
+  size_t pending_chunk_length_ = 0;
+  std::string_view deferred_chunk_;
+  base::OnceClosure deferred_resume_;
+
   mojo::ReceiverSet<network::mojom::URLLoaderNetworkServiceObserver>
       url_loader_network_observer_receivers_;
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
@@ -27,6 +27,7 @@
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/process_util.h"
+#include "shell/common/sampling_cpu_profiler.h"
 #include "shell/common/thread_restrictions.h"
 #include "third_party/blink/renderer/platform/heap/process_heap.h"  // nogncheck
 
@@ -76,6 +77,9 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   BindProcess(isolate, &dict, metrics_.get());
 
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
+  dict.SetMethod("startCpuProfiling", &StartCpuProfiling);
+  dict.SetMethod("stopCpuProfiling", &StopCpuProfiling);
+  dict.SetMethod("writeCpuProfile", &WriteCpuProfile);
 #if BUILDFLAG(IS_POSIX)
   dict.SetMethod("setFdLimit", &base::IncreaseFdLimitTo);
 #endif
@@ -308,4 +312,57 @@ bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
   return electron::TakeHeapSnapshot(isolate, &file);
 }
 
+// static
+void ElectronBindings::StartCpuProfiling(v8::Isolate* isolate,
+                                         gin_helper::Arguments* args) {
+  if (SamplingCpuProfiler::Get()) {
+    args->ThrowError("CPU profiling is already running");
+    return;
+  }
+
+  // 10ms keeps the sampler well below 1% of a core while still catching any
+  // task long enough to be felt as jank.
+  double sampling_interval = 10;
+  double window_duration = 60000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("windowDuration", &window_duration);
+  }
+  if (!(sampling_interval >= 0.1 && sampling_interval <= 1000)) {
+    args->ThrowError("samplingInterval must be between 0.1 and 1000");
+    return;
+  }
+  if (!(window_duration >= sampling_interval)) {
+    args->ThrowError("windowDuration must be at least samplingInterval");
+    return;
+  }
+
+  if (!SamplingCpuProfiler::Start(isolate,
+                                  base::Milliseconds(sampling_interval),
+                                  base::Milliseconds(window_duration))) {
+    args->ThrowError("CPU profiling is not supported in this context");
+  }
+}
+
+// static
+void ElectronBindings::StopCpuProfiling() {
+  if (auto* profiler = SamplingCpuProfiler::Get())
+    profiler->Stop();
+}
+
+// static
+bool ElectronBindings::WriteCpuProfile(const base::FilePath& file_path) {
+  auto* profiler = SamplingCpuProfiler::Get();
+  if (!profiler)
+    return false;
+
+  ScopedAllowBlockingForElectron allow_blocking;
+
+  base::File file(file_path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+
+  return profiler->WriteProfile(&file);
+}
+
 }  // namespace electron
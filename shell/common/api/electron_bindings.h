@@ -75,6 +75,10 @@ class ElectronBindings {
                                           v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
+  static void StartCpuProfiling(v8::Isolate* isolate,
+                                gin_helper::Arguments* args);
+  static void StopCpuProfiling();
+  static bool WriteCpuProfile(const base::FilePath& file_path);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
@@ -722,4 +722,18 @@ v8::Local<v8::Value> Converter<blink::mojom::ConsoleMessageLevel>::ToV8(
   return StringToV8(isolate, Lookup.at(in));
 }
 
+bool Converter<blink::mojom::ConsoleMessageLevel>::FromV8(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> val,
+    blink::mojom::ConsoleMessageLevel* out) {
+  using Val = blink::mojom::ConsoleMessageLevel;
+  static constexpr auto Lookup = base::MakeFixedFlatMap<std::string_view, Val>({
+      {"debug", Val::kVerbose},
+      {"error", Val::kError},
+      {"info", Val::kInfo},
+      {"warning", Val::kWarning},
+  });
+  return FromV8WithLookup(isolate, val, Lookup, out);
+}
+
 }  // namespace gin
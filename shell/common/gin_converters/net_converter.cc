@@ -162,20 +162,8 @@ v8::Local<v8::Value> Converter<net::CertPrincipal>::ToV8(
 v8::Local<v8::Value> Converter<net::HttpResponseHeaders*>::ToV8(
     v8::Isolate* isolate,
     net::HttpResponseHeaders* headers) {
-  base::Value::Dict response_headers;
-  if (headers) {
-    size_t iter = 0;
-    std::string key;
-    std::string value;
-    while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-      key = base::ToLowerASCII(key);
-      base::Value::List* values = response_headers.FindList(key);
-      if (!values)
-        values = &response_headers.Set(key, base::Value::List())->GetList();
-      values->Append(value);
-    }
-  }
-  return ConvertToV8(isolate, response_headers);
+  return electron::HttpResponseHeadersToV8(isolate, headers,
+                                          /*lowercase_names=*/true);
 }
 
 bool Converter<net::HttpResponseHeaders*>::FromV8(
@@ -768,3 +756,40 @@ bool Converter<network::mojom::ResolveHostParametersPtr>::FromV8(
 }
 
 }  // namespace gin
+
+namespace electron {
+
+v8::Local<v8::Object> HttpResponseHeadersToV8(
+    v8::Isolate* isolate,
+    const net::HttpResponseHeaders* headers,
+    bool lowercase_names) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Object> response_headers = v8::Object::New(isolate);
+  if (!headers)
+    return response_headers;
+
+  size_t iter = 0;
+  std::string key;
+  std::string value;
+  while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
+    v8::Local<v8::String> v8_key = gin::StringToV8(
+        isolate, lowercase_names ? base::ToLowerASCII(key) : key);
+    v8::Local<v8::Value> existing;
+    v8::Local<v8::Array> values;
+    if (response_headers->HasOwnProperty(context, v8_key).FromMaybe(false) &&
+        response_headers->Get(context, v8_key).ToLocal(&existing) &&
+        existing->IsArray()) {
+      values = existing.As<v8::Array>();
+    } else {
+      values = v8::Array::New(isolate);
+      response_headers->CreateDataProperty(context, v8_key, values).Check();
+    }
+    values
+        ->CreateDataProperty(context, values->Length(),
+                             gin::StringToV8(isolate, value))
+        .Check();
+  }
+  return response_headers;
+}
+
+}  // namespace electron
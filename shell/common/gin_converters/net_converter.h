@@ -26,6 +26,18 @@ struct ResourceRequest;
 class ResourceRequestBody;
 }  // namespace network
 
+namespace electron {
+
+// Converts |headers| to an object mapping each header name to the array of
+// its values, built directly as V8 values as these can be large and are
+// converted for every response. The names are lowercased if |lowercase_names|.
+v8::Local<v8::Object> HttpResponseHeadersToV8(
+    v8::Isolate* isolate,
+    const net::HttpResponseHeaders* headers,
+    bool lowercase_names);
+
+}  // namespace electron
+
 namespace gin {
 
 template <>
@@ -7,6 +7,7 @@
 #include "base/no_destructor.h"
 #include "gin/converter.h"
 #include "shell/common/gin_helper/wrappable_base.h"
+#include "v8/include/v8-fast-api-calls.h"
 #include "v8/include/v8-function.h"
 
 namespace gin_helper {
@@ -39,6 +40,29 @@ void IsDestroyedFunc(const v8::FunctionCallbackInfo<v8::Value>& info) {
       info.GetIsolate(), Destroyable::IsDestroyed(info.This())));
 }
 
+bool FastIsDestroyedFunc(v8::Local<v8::Value> receiver) {
+  return !receiver->IsObject() ||
+         Destroyable::IsDestroyed(receiver.As<v8::Object>());
+}
+
+void EnsureFuncTemplates(v8::Isolate* isolate) {
+  if (!GetDestroyFunc()->IsEmpty())
+    return;
+
+  auto templ = v8::FunctionTemplate::New(isolate, DestroyFunc);
+  templ->RemovePrototype();
+  GetDestroyFunc()->Reset(isolate, templ);
+
+  static const v8::CFunction fast_is_destroyed =
+      v8::CFunction::Make(FastIsDestroyedFunc);
+  templ = v8::FunctionTemplate::New(
+      isolate, IsDestroyedFunc, v8::Local<v8::Value>(),
+      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+      v8::SideEffectType::kHasSideEffect, &fast_is_destroyed);
+  templ->RemovePrototype();
+  GetIsDestroyedFunc()->Reset(isolate, templ);
+}
+
 }  // namespace
 
 // static
@@ -49,18 +73,18 @@ bool Destroyable::IsDestroyed(v8::Local<v8::Object> object) {
          object->GetAlignedPointerFromInternalField(0) == nullptr;
 }
 
+// static
+v8::Local<v8::FunctionTemplate> Destroyable::GetIsDestroyedTemplate(
+    v8::Isolate* isolate) {
+  EnsureFuncTemplates(isolate);
+  return v8::Local<v8::FunctionTemplate>::New(isolate, *GetIsDestroyedFunc());
+}
+
 // static
 void Destroyable::MakeDestroyable(v8::Isolate* isolate,
                                   v8::Local<v8::FunctionTemplate> prototype) {
   // Cache the FunctionTemplate of "destroy" and "isDestroyed".
-  if (GetDestroyFunc()->IsEmpty()) {
-    auto templ = v8::FunctionTemplate::New(isolate, DestroyFunc);
-    templ->RemovePrototype();
-    GetDestroyFunc()->Reset(isolate, templ);
-    templ = v8::FunctionTemplate::New(isolate, IsDestroyedFunc);
-    templ->RemovePrototype();
-    GetIsDestroyedFunc()->Reset(isolate, templ);
-  }
+  EnsureFuncTemplates(isolate);
 
   auto proto_templ = prototype->PrototypeTemplate();
   proto_templ->Set(
@@ -14,6 +14,11 @@ struct Destroyable {
   // Determine whether the native object has been destroyed.
   static bool IsDestroyed(v8::Local<v8::Object> object);
 
+  // Returns the template of "isDestroyed", which optimized code can call
+  // through the V8 fast API.
+  static v8::Local<v8::FunctionTemplate> GetIsDestroyedTemplate(
+      v8::Isolate* isolate);
+
   // Add "destroy" and "isDestroyed" to prototype chain.
   static void MakeDestroyable(v8::Isolate* isolate,
                               v8::Local<v8::FunctionTemplate> prototype);
@@ -12,6 +12,7 @@
 #include "shell/common/gin_helper/event.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/gin_helper/wrappable.h"
+#include "shell/common/task_attribution.h"
 
 namespace content {
 class RenderFrameHost;
@@ -26,6 +27,7 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   // this.emit(name, new Event(), args...);
   template <typename... Args>
   bool Emit(const std::string_view name, Args&&... args) {
+    electron::task_attribution::Record("event", name);
     v8::Isolate* const isolate = this->isolate();
     v8::HandleScope handle_scope{isolate};
     v8::Local<v8::Object> wrapper = this->GetWrapper();
@@ -41,6 +43,7 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   // this.emit(name, args...);
   template <typename... Args>
   void EmitWithoutEvent(const std::string_view name, Args&&... args) {
+    electron::task_attribution::Record("event", name);
     v8::Isolate* const isolate = this->isolate();
     v8::HandleScope handle_scope{isolate};
     v8::Local<v8::Object> wrapper = this->GetWrapper();
@@ -80,4 +80,9 @@ void ThrowConversionError(gin::Arguments* args,
   }
 }
 
+void ThrowFastCallError(v8::Isolate* isolate, std::string_view message) {
+  v8::HandleScope handle_scope(isolate);
+  ErrorThrower(isolate).ThrowTypeError(message);
+}
+
 }  // namespace gin_helper
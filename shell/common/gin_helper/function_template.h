@@ -5,7 +5,10 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 #define ELECTRON_SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 
+#include <cstdint>
 #include <optional>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 #include "base/functional/bind.h"
@@ -19,11 +22,13 @@
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "v8/include/v8-context.h"
 #include "v8/include/v8-external.h"
+#include "v8/include/v8-fast-api-calls.h"
 #include "v8/include/v8-template.h"
 
-// This file is forked from gin/function_template.h with 2 differences:
+// This file is forked from gin/function_template.h with 3 differences:
 // 1. Support for additional types of arguments.
 // 2. Support for warning using destroyed objects.
+// 3. Support for V8 fast API calls, see CreateFastFunctionTemplate().
 //
 // TODO(zcbenz): We should seek to remove this file after removing native_mate.
 
@@ -345,11 +350,15 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
 // relied upon. As such, any destructors for objects bound to the callback must
 // not depend on the isolate being alive at the point they are called. The order
 // in which callbacks are destroyed is not guaranteed.
+//
+// |c_function|, if given, is called instead of the callback from optimized
+// code. It has to outlive the template.
 template <typename Sig>
 v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
     v8::Isolate* isolate,
     base::RepeatingCallback<Sig> callback,
-    InvokerOptions invoker_options = {}) {
+    InvokerOptions invoker_options = {},
+    const v8::CFunction* c_function = nullptr) {
   typedef CallbackHolder<Sig> HolderT;
   HolderT* holder =
       new HolderT(isolate, std::move(callback), std::move(invoker_options));
@@ -358,7 +367,8 @@ v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
       isolate, &Dispatcher<Sig>::DispatchToCallback,
       gin::ConvertToV8<v8::Local<v8::External>>(isolate,
                                                 holder->GetHandle(isolate)),
-      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow);
+      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+      v8::SideEffectType::kHasSideEffect, c_function);
   return tmpl;
 }
 
@@ -420,6 +430,88 @@ struct CallbackTraits<
   }
 };
 
+// Types that V8 passes to and returns from fast API calls as they are.
+template <typename T>
+inline constexpr bool kIsFastApiType =
+    std::is_same_v<T, bool> || std::is_same_v<T, int32_t> ||
+    std::is_same_v<T, uint32_t> || std::is_same_v<T, float> ||
+    std::is_same_v<T, double>;
+
+// Throws a TypeError from within a fast API call.
+void ThrowFastCallError(v8::Isolate* isolate, std::string_view message);
+
+// Gets the object a fast API call was made on, throwing the same errors as
+// ArgumentHolder does when it has been destroyed or is of the wrong type.
+template <typename T>
+T* GetFastCallHolder(v8::Local<v8::Value> receiver,
+                     v8::FastApiCallbackOptions& options) {
+  if (receiver->IsObject() &&
+      Destroyable::IsDestroyed(receiver.As<v8::Object>())) {
+    ThrowFastCallError(options.isolate, "Object has been destroyed");
+    return nullptr;
+  }
+  T* holder = nullptr;
+  if (!gin::ConvertFromV8(options.isolate, receiver, &holder) || !holder) {
+    ThrowFastCallError(options.isolate, "Illegal invocation");
+    return nullptr;
+  }
+  return holder;
+}
+
+template <auto kMethod, typename T, typename ReturnType, typename... ArgTypes>
+struct FastMethodCall {
+  static_assert(std::is_void_v<ReturnType> || kIsFastApiType<ReturnType>,
+                "Fast API calls can only return void or primitives");
+  static_assert((... && kIsFastApiType<ArgTypes>),
+                "Fast API calls can only take primitive arguments");
+
+  static ReturnType Call(v8::Local<v8::Value> receiver,
+                         ArgTypes... args,
+                         v8::FastApiCallbackOptions& options) {
+    T* holder = GetFastCallHolder<T>(receiver, options);
+    if (!holder)
+      return ReturnType();
+    return (holder->*kMethod)(args...);
+  }
+};
+
+// FastMethod<&Class::Method>::Call is the fast API counterpart of binding
+// Class::Method with CallbackTraits.
+template <auto kMethod>
+struct FastMethod;
+
+template <typename T,
+          typename ReturnType,
+          typename... ArgTypes,
+          ReturnType (T::*kMethod)(ArgTypes...)>
+struct FastMethod<kMethod>
+    : FastMethodCall<kMethod, T, ReturnType, ArgTypes...> {};
+
+template <typename T,
+          typename ReturnType,
+          typename... ArgTypes,
+          ReturnType (T::*kMethod)(ArgTypes...) const>
+struct FastMethod<kMethod>
+    : FastMethodCall<kMethod, T, ReturnType, ArgTypes...> {};
+
+// CreateFastFunctionTemplate works like CallbackTraits<>::CreateTemplate for
+// the member function |kMethod|, and additionally lets optimized code call it
+// directly through the V8 fast API, skipping gin::Arguments and the
+// conversions of the regular path.
+//
+// Only use it for cheap methods that take and return primitives, and that
+// neither call into JS nor allocate on the V8 heap, e.g. simple getters.
+template <auto kMethod>
+v8::Local<v8::FunctionTemplate> CreateFastFunctionTemplate(
+    v8::Isolate* isolate) {
+  static const v8::CFunction c_function =
+      v8::CFunction::Make(FastMethod<kMethod>::Call);
+  InvokerOptions invoker_options = {.holder_is_first_argument = true};
+  return gin_helper::CreateFunctionTemplate(
+      isolate, base::BindRepeating(kMethod), std::move(invoker_options),
+      &c_function);
+}
+
 }  // namespace gin_helper
 
 #endif  // ELECTRON_SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
@@ -43,6 +43,13 @@ class ObjectTemplateBuilder {
                                    const T& callback) {
     return SetImpl(name, CallbackTraits<T>::CreateTemplate(isolate_, callback));
   }
+  // Like SetMethod() for the member function |kMethod|, but also lets
+  // optimized code call it through the V8 fast API. See
+  // gin_helper::CreateFastFunctionTemplate() for the methods this suits.
+  template <auto kMethod>
+  ObjectTemplateBuilder& SetFastMethod(const std::string_view name) {
+    return SetImpl(name, CreateFastFunctionTemplate<kMethod>(isolate_));
+  }
   template <typename T>
   ObjectTemplateBuilder& SetProperty(const std::string_view name,
                                      const T& getter) {
@@ -4,15 +4,56 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "base/containers/span.h"
 #include "base/files/file.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task/thread_pool.h"
+#include "base/thread_annotations.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 #include "v8/include/v8.h"
 
 namespace {
 
+// Size of the blocks handed to the background writer.
+constexpr size_t kBlockSize = 1024 * 1024;
+
+// Serialization pauses while this much is waiting to be written, so that a
+// slow target doesn't make the whole snapshot pile up in memory.
+constexpr size_t kMaxPendingBytes = 16 * kBlockSize;
+
+// How long serialization waits for a stalled writer before giving up on the
+// snapshot, so that a hung target can't block the thread forever.
+constexpr base::TimeDelta kMaxWriteStall = base::Seconds(30);
+
+// SAFETY: since WriteAsciiChunk() only gives us data + size, our
+// UNSAFE_BUFFERS macro call is unavoidable here. It can be removed
+// if/when v8 changes WriteAsciiChunk() to pass a v8::MemorySpan.
+base::span<const char> ToSpan(const char* data, int size) {
+  return UNSAFE_BUFFERS(base::span{data, base::saturated_cast<size_t>(size)});
+}
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
   explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
@@ -26,11 +67,7 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   void EndOfStream() override { is_complete_ = true; }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    // SAFETY: since WriteAsciiChunk() only gives us data + size, our
-    // UNSAFE_BUFFERS macro call is unavoidable here. It can be removed
-    // if/when v8 changes WriteAsciiChunk() to pass a v8::MemorySpan.
-    const auto data_span = base::as_bytes(
-        UNSAFE_BUFFERS(base::span{data, base::saturated_cast<size_t>(size)}));
+    const auto data_span = base::as_bytes(ToSpan(data, size));
     return file_->WriteAtCurrentPosAndCheck(data_span) ? kContinue : kAbort;
   }
 
@@ -39,6 +76,194 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+// Tracks how far the writer is behind the serializing thread.
+class WriteBacklog : public base::RefCountedThreadSafe<WriteBacklog> {
+ public:
+  WriteBacklog() = default;
+
+  // disable copy
+  WriteBacklog(const WriteBacklog&) = delete;
+  WriteBacklog& operator=(const WriteBacklog&) = delete;
+
+  // Called on the serializing thread before handing |size| bytes to the
+  // writer. Waits while the writer is too far behind, and returns false once
+  // it has failed or stayed too far behind for kMaxWriteStall.
+  bool Add(size_t size) {
+    base::AutoLock lock(lock_);
+    const base::TimeTicks deadline = base::TimeTicks::Now() + kMaxWriteStall;
+    while (pending_ > kMaxPendingBytes && !failed_) {
+      const base::TimeDelta remaining = deadline - base::TimeTicks::Now();
+      if (!remaining.is_positive()) {
+        LOG(ERROR) << "Heap snapshot writer stalled, aborting the snapshot.";
+        failed_ = true;
+        break;
+      }
+      drained_.TimedWait(remaining);
+    }
+    pending_ += size;
+    return !failed_;
+  }
+
+  // Called on the writer's sequence once |size| bytes have been handled.
+  void Done(size_t size, bool success) {
+    base::AutoLock lock(lock_);
+    pending_ -= size;
+    failed_ = failed_ || !success;
+    drained_.Signal();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<WriteBacklog>;
+
+  ~WriteBacklog() = default;
+
+  base::Lock lock_;
+  base::ConditionVariable drained_{&lock_};
+  size_t pending_ GUARDED_BY(lock_) = 0;
+  bool failed_ GUARDED_BY(lock_) = false;
+};
+
+// Compresses and writes a snapshot on a background sequence.
+class HeapSnapshotWriter {
+ public:
+  HeapSnapshotWriter(base::File file,
+                     bool compress,
+                     scoped_refptr<WriteBacklog> backlog)
+      : file_(std::move(file)),
+        compress_(compress),
+        backlog_(std::move(backlog)) {
+    // Favor speed over ratio so the writer keeps up with serialization; the
+    // JSON compresses well either way. The extra 16 window bits ask for a
+    // gzip header.
+    if (compress_) {
+      ok_ = deflateInit2(&zstream_, Z_BEST_SPEED, Z_DEFLATED, MAX_WBITS + 16,
+                         8, Z_DEFAULT_STRATEGY) == Z_OK;
+    }
+  }
+
+  ~HeapSnapshotWriter() {
+    if (compress_)
+      deflateEnd(&zstream_);
+  }
+
+  // disable copy
+  HeapSnapshotWriter(const HeapSnapshotWriter&) = delete;
+  HeapSnapshotWriter& operator=(const HeapSnapshotWriter&) = delete;
+
+  void Write(const std::string& block) {
+    if (ok_) {
+      ok_ = compress_ ? Deflate(block, Z_NO_FLUSH)
+                      : file_.WriteAtCurrentPosAndCheck(
+                            base::as_byte_span(block));
+    }
+    backlog_->Done(block.size(), ok_);
+  }
+
+  bool Finish() {
+    if (ok_ && compress_)
+      ok_ = Deflate({}, Z_FINISH);
+    file_.Close();
+    return ok_;
+  }
+
+ private:
+  bool Deflate(std::string_view input, int flush) {
+    zstream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zstream_.avail_in = base::checked_cast<uInt>(input.size());
+    do {
+      zstream_.next_out = output_.data();
+      zstream_.avail_out = base::checked_cast<uInt>(output_.size());
+      if (deflate(&zstream_, flush) == Z_STREAM_ERROR)
+        return false;
+      const size_t produced = output_.size() - zstream_.avail_out;
+      if (produced > 0 && !file_.WriteAtCurrentPosAndCheck(
+                              base::span(output_).first(produced)))
+        return false;
+    } while (zstream_.avail_out == 0);
+    return true;
+  }
+
+  base::File file_;
+  const bool compress_;
+  scoped_refptr<WriteBacklog> backlog_;
+  z_stream zstream_ = {};
+  std::vector<uint8_t> output_ = std::vector<uint8_t>(256 * 1024);
+  bool ok_ = true;
+};
+
+// Hands the serialized snapshot to a HeapSnapshotWriter in blocks.
+class StreamingOutputStream : public v8::OutputStream {
+ public:
+  StreamingOutputStream(base::SequenceBound<HeapSnapshotWriter>* writer,
+                        scoped_refptr<WriteBacklog> backlog)
+      : writer_(writer), backlog_(std::move(backlog)) {}
+
+  [[nodiscard]] bool IsComplete() const { return is_complete_; }
+
+  // v8::OutputStream
+  int GetChunkSize() override { return 65536; }
+  void EndOfStream() override { is_complete_ = PostBlock(); }
+
+  v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
+    const auto data_span = ToSpan(data, size);
+    block_.append(data_span.begin(), data_span.end());
+    if (block_.size() >= kBlockSize && !PostBlock())
+      return kAbort;
+    return kContinue;
+  }
+
+ private:
+  bool PostBlock() {
+    if (block_.empty())
+      return true;
+    if (!backlog_->Add(block_.size()))
+      return false;
+    writer_->AsyncCall(&HeapSnapshotWriter::Write)
+        .WithArgs(std::exchange(block_, {}));
+    return true;
+  }
+
+  raw_ptr<base::SequenceBound<HeapSnapshotWriter>> writer_;
+  scoped_refptr<WriteBacklog> backlog_;
+  std::string block_;
+  bool is_complete_ = false;
+};
+
+// |depth| tracks how deeply the resulting JSON nests, which grows with the
+// stack depth of the sampled allocations.
+base::Value::Dict SerializeAllocationNode(
+    v8::Isolate* isolate,
+    const v8::AllocationProfile::Node* node,
+    size_t* depth) {
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value::List children;
+  size_t children_depth = 0;
+  for (const auto* child : node->children) {
+    size_t child_depth = 0;
+    children.Append(SerializeAllocationNode(isolate, child, &child_depth));
+    children_depth = std::max(children_depth, child_depth);
+  }
+  // The node dictionary and its children list, or its call frame for leaves.
+  *depth = 2 + children_depth;
+
+  // Line and column numbers are 0-based in the DevTools format.
+  return base::Value::Dict()
+      .Set("callFrame",
+           base::Value::Dict()
+               .Set("functionName", gin::V8ToString(isolate, node->name))
+               .Set("scriptId", base::NumberToString(node->script_id))
+               .Set("url", gin::V8ToString(isolate, node->script_name))
+               .Set("lineNumber", node->line_number - 1)
+               .Set("columnNumber", node->column_number - 1))
+      .Set("selfSize", self_size)
+      .Set("id", base::checked_cast<int>(node->node_id))
+      .Set("children", std::move(children));
+}
+
 }  // namespace
 
 namespace electron {
@@ -62,4 +287,70 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   return stream.IsComplete();
 }
 
+void StreamHeapSnapshot(v8::Isolate* isolate,
+                        base::File file,
+                        bool compress,
+                        base::OnceCallback<void(bool)> callback) {
+  DCHECK(isolate);
+
+  if (!file.IsValid()) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  auto backlog = base::MakeRefCounted<WriteBacklog>();
+  base::SequenceBound<HeapSnapshotWriter> writer(
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+      std::move(file), compress, backlog);
+
+  bool complete = false;
+  if (auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot()) {
+    StreamingOutputStream stream(&writer, std::move(backlog));
+    snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+    const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+    complete = stream.IsComplete();
+  }
+
+  writer.AsyncCall(&HeapSnapshotWriter::Finish)
+      .Then(base::BindOnce(
+          [](base::OnceCallback<void(bool)> callback, bool complete,
+             bool written) { std::move(callback).Run(complete && written); },
+          std::move(callback), complete));
+}
+
+bool StopSamplingHeapProfiler(v8::Isolate* isolate, base::File* file) {
+  DCHECK(isolate);
+  DCHECK(file);
+
+  v8::HandleScope handle_scope(isolate);
+  v8::HeapProfiler* profiler = isolate->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      profiler->GetAllocationProfile());
+  profiler->StopSamplingHeapProfiler();
+  if (!profile || !file->IsValid())
+    return false;
+
+  base::Value::List samples;
+  for (const auto& sample : profile->GetSamples()) {
+    samples.Append(
+        base::Value::Dict()
+            .Set("size", static_cast<double>(sample.size) * sample.count)
+            .Set("nodeId", base::checked_cast<int>(sample.node_id))
+            .Set("ordinal", static_cast<double>(sample.sample_id)));
+  }
+
+  size_t depth = 0;
+  base::Value::Dict head =
+      SerializeAllocationNode(isolate, profile->GetRootNode(), &depth);
+  // Deep stacks nest further than the default limit of the writer allows.
+  std::optional<std::string> json =
+      base::WriteJson(base::Value::Dict()
+                          .Set("head", std::move(head))
+                          .Set("samples", std::move(samples)),
+                      depth + 4);
+  return json && file->WriteAtCurrentPosAndCheck(base::as_byte_span(*json));
+}
+
 }  // namespace electron
@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include "base/functional/callback_forward.h"
+
 namespace base {
 class File;
 }
@@ -17,6 +19,22 @@ namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Like TakeHeapSnapshot(), but |file| is written on a background sequence,
+// gzip-compressing the snapshot on the way when |compress| is set. The
+// snapshot is still taken and serialized on the calling thread, which only
+// waits for the writer when it falls far behind, so slow targets like pipes
+// and sockets don't stall it for the whole transfer. |callback| is run on the
+// calling sequence with whether the whole snapshot was written.
+void StreamHeapSnapshot(v8::Isolate* isolate,
+                        base::File file,
+                        bool compress,
+                        base::OnceCallback<void(bool)> callback);
+
+// Writes the allocations sampled since the sampling heap profiler of |isolate|
+// was started to |file|, in the .heapprofile format of the DevTools Memory
+// panel, and stops the profiler.
+bool StopSamplingHeapProfiler(v8::Isolate* isolate, base::File* file);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
@@ -0,0 +1,268 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/sampling_cpu_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/containers/adapters.h"
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/functional/bind.h"
+#include "base/json/json_writer.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+
+namespace electron {
+
+namespace {
+
+constinit thread_local SamplingCpuProfiler* g_profiler = nullptr;
+
+constexpr int kRootNodeId = 1;
+
+// Merges the call trees of several profiles into the flat node list of a
+// .cpuprofile, joining the nodes that have the same frame and parent.
+class CallTreeMerger {
+ public:
+  CallTreeMerger() {
+    nodes_.push_back(MakeNode(kRootNodeId, "(root)", 0, "", 0, 0));
+  }
+
+  // disable copy
+  CallTreeMerger(const CallTreeMerger&) = delete;
+  CallTreeMerger& operator=(const CallTreeMerger&) = delete;
+
+  int AddSample(const v8::CpuProfileNode* node) {
+    const int id = GetNodeId(node);
+    nodes_[id - 1].Set("hitCount",
+                       nodes_[id - 1].FindInt("hitCount").value_or(0) + 1);
+    return id;
+  }
+
+  base::Value::List TakeNodes() {
+    base::Value::List nodes;
+    for (auto& node : nodes_)
+      nodes.Append(std::move(node));
+    nodes_.clear();
+    return nodes;
+  }
+
+ private:
+  using Key = std::tuple<int, int, int, int, std::string>;
+
+  static base::Value::Dict MakeNode(int id,
+                                    const char* function_name,
+                                    int script_id,
+                                    const char* url,
+                                    int line_number,
+                                    int column_number) {
+    // Line and column numbers are 0-based in the DevTools format.
+    return base::Value::Dict()
+        .Set("id", id)
+        .Set("callFrame",
+             base::Value::Dict()
+                 .Set("functionName", function_name)
+                 .Set("scriptId", base::NumberToString(script_id))
+                 .Set("url", url)
+                 .Set("lineNumber", line_number - 1)
+                 .Set("columnNumber", column_number - 1))
+        .Set("hitCount", 0)
+        .Set("children", base::Value::List());
+  }
+
+  int GetNodeId(const v8::CpuProfileNode* node) {
+    // Walk up to the closest ancestor that was already merged, then add the
+    // missing nodes on the way back down. Stacks can be too deep to recurse.
+    std::vector<const v8::CpuProfileNode*> path;
+    int parent_id = kRootNodeId;
+    for (; node->GetParent(); node = node->GetParent()) {
+      if (auto iter = merged_.find(node); iter != merged_.end()) {
+        parent_id = iter->second;
+        break;
+      }
+      path.push_back(node);
+    }
+    for (const auto* child : base::Reversed(path)) {
+      parent_id = AddNode(parent_id, child);
+      merged_.emplace(child, parent_id);
+    }
+    return parent_id;
+  }
+
+  int AddNode(int parent_id, const v8::CpuProfileNode* node) {
+    auto [iter, inserted] = ids_.try_emplace(
+        Key(parent_id, node->GetScriptId(), node->GetLineNumber(),
+            node->GetColumnNumber(), node->GetFunctionNameStr()),
+        static_cast<int>(nodes_.size()) + 1);
+    if (inserted) {
+      nodes_.push_back(MakeNode(
+          iter->second, node->GetFunctionNameStr(), node->GetScriptId(),
+          node->GetScriptResourceNameStr(), node->GetLineNumber(),
+          node->GetColumnNumber()));
+      nodes_[parent_id - 1].FindList("children")->Append(iter->second);
+    }
+    return iter->second;
+  }
+
+  std::vector<base::Value::Dict> nodes_;
+  std::map<Key, int> ids_;
+  std::map<const v8::CpuProfileNode*, int> merged_;
+};
+
+}  // namespace
+
+// static
+SamplingCpuProfiler* SamplingCpuProfiler::Get() {
+  return g_profiler;
+}
+
+// static
+SamplingCpuProfiler* SamplingCpuProfiler::Start(
+    v8::Isolate* isolate,
+    base::TimeDelta sampling_interval,
+    base::TimeDelta window) {
+  DCHECK(!g_profiler);
+  // Without PerIsolateData there is no way to learn about the isolate going
+  // away before the profiler does.
+  auto* per_isolate_data = gin::PerIsolateData::From(isolate);
+  if (!per_isolate_data)
+    return nullptr;
+  g_profiler = new SamplingCpuProfiler(isolate, per_isolate_data,
+                                       sampling_interval, window);
+  return g_profiler;
+}
+
+SamplingCpuProfiler::SamplingCpuProfiler(v8::Isolate* isolate,
+                                         gin::PerIsolateData* per_isolate_data,
+                                         base::TimeDelta sampling_interval,
+                                         base::TimeDelta window)
+    : per_isolate_data_(per_isolate_data),
+      sampling_interval_(sampling_interval),
+      window_(window),
+      profiler_(v8::CpuProfiler::New(isolate)) {
+  per_isolate_data_->AddDisposeObserver(this);
+  // The sampler thread wakes up at this interval no matter what the profiles
+  // ask for, so it has to be raised along with theirs to keep the overhead
+  // down. Precise sampling busy-waits on Windows.
+  profiler_->SetSamplingInterval(
+      base::checked_cast<int>(sampling_interval_.InMicroseconds()));
+  profiler_->SetUsePreciseSampling(false);
+  StartSegment();
+  rotate_timer_.Start(FROM_HERE, window_,
+                      base::BindRepeating(&SamplingCpuProfiler::Rotate,
+                                          base::Unretained(this)));
+}
+
+SamplingCpuProfiler::~SamplingCpuProfiler() {
+  Shutdown();
+  per_isolate_data_->RemoveDisposeObserver(this);
+  g_profiler = nullptr;
+}
+
+void SamplingCpuProfiler::Stop() {
+  delete this;
+}
+
+bool SamplingCpuProfiler::WriteProfile(base::File* file) {
+  DCHECK(file);
+  EndSegment();
+
+  bool success = false;
+  if (!segments_.empty() && file->IsValid()) {
+    const int64_t end_time = segments_.back()->GetEndTime();
+    const int64_t start_time =
+        std::max(segments_.front()->GetStartTime(),
+                 end_time - window_.InMicroseconds());
+
+    CallTreeMerger merger;
+    base::Value::List samples;
+    base::Value::List time_deltas;
+    int64_t last_time = start_time;
+    for (const v8::CpuProfile* segment : segments_) {
+      for (int i = 0; i < segment->GetSamplesCount(); ++i) {
+        const int64_t time = segment->GetSampleTimestamp(i);
+        if (time < start_time)
+          continue;
+        samples.Append(merger.AddSample(segment->GetSample(i)));
+        time_deltas.Append(static_cast<double>(time - last_time));
+        last_time = time;
+      }
+    }
+
+    std::optional<std::string> json =
+        base::WriteJson(base::Value::Dict()
+                            .Set("nodes", merger.TakeNodes())
+                            .Set("startTime", static_cast<double>(start_time))
+                            .Set("endTime", static_cast<double>(end_time))
+                            .Set("samples", std::move(samples))
+                            .Set("timeDeltas", std::move(time_deltas)));
+    success =
+        json && file->WriteAtCurrentPosAndCheck(base::as_byte_span(*json));
+  }
+
+  StartSegment();
+  return success;
+}
+
+void SamplingCpuProfiler::OnBeforeDispose(v8::Isolate* isolate) {
+  // The profiles have to go while the isolate is still around.
+  Shutdown();
+}
+
+void SamplingCpuProfiler::OnDisposed() {
+  delete this;
+}
+
+void SamplingCpuProfiler::StartSegment() {
+  v8::CpuProfilingResult result = profiler_->Start(v8::CpuProfilingOptions(
+      v8::kLeafNodeLineNumbers, v8::CpuProfilingOptions::kNoSampleLimit,
+      base::checked_cast<int>(sampling_interval_.InMicroseconds())));
+  current_id_ =
+      result.status == v8::CpuProfilingStatus::kErrorTooManyProfilers
+          ? 0
+          : result.id;
+}
+
+void SamplingCpuProfiler::EndSegment() {
+  if (!current_id_)
+    return;
+  if (v8::CpuProfile* profile = profiler_->Stop(current_id_))
+    segments_.push_back(profile);
+  current_id_ = 0;
+}
+
+void SamplingCpuProfiler::Rotate() {
+  EndSegment();
+  StartSegment();
+
+  if (segments_.empty())
+    return;
+  const int64_t cutoff =
+      segments_.back()->GetEndTime() - window_.InMicroseconds();
+  while (!segments_.empty() && segments_.front()->GetEndTime() <= cutoff) {
+    segments_.front()->Delete();
+    segments_.pop_front();
+  }
+}
+
+void SamplingCpuProfiler::Shutdown() {
+  if (!profiler_)
+    return;
+  rotate_timer_.Stop();
+  EndSegment();
+  for (v8::CpuProfile* segment : segments_)
+    segment->Delete();
+  segments_.clear();
+  profiler_.ExtractAsDangling()->Dispose();
+}
+
+}  // namespace electron
@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_SAMPLING_CPU_PROFILER_H_
+#define ELECTRON_SHELL_COMMON_SAMPLING_CPU_PROFILER_H_
+
+#include <deque>
+
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "gin/per_isolate_data.h"
+#include "v8/include/v8-profiler.h"
+
+namespace base {
+class File;
+}
+
+namespace electron {
+
+// Samples the JS stacks of an isolate for as long as it runs, keeping only
+// the samples of the last |window|, so that it can be left on in production
+// and dumped once something went wrong. There is at most one profiler per
+// thread.
+class SamplingCpuProfiler : public gin::PerIsolateData::DisposeObserver {
+ public:
+  // Returns the profiler running on the current thread, if any.
+  static SamplingCpuProfiler* Get();
+
+  // Starts profiling |isolate| on the current thread. Returns nullptr when
+  // |isolate| can't be profiled, e.g. in a Node.js Worker.
+  static SamplingCpuProfiler* Start(v8::Isolate* isolate,
+                                    base::TimeDelta sampling_interval,
+                                    base::TimeDelta window);
+
+  // disable copy
+  SamplingCpuProfiler(const SamplingCpuProfiler&) = delete;
+  SamplingCpuProfiler& operator=(const SamplingCpuProfiler&) = delete;
+
+  // Stops profiling and deletes the profiler.
+  void Stop();
+
+  // Writes the samples of the last |window| to |file|, in the .cpuprofile
+  // format of the DevTools Performance panel. Profiling goes on afterwards.
+  bool WriteProfile(base::File* file);
+
+  // gin::PerIsolateData::DisposeObserver
+  void OnBeforeDispose(v8::Isolate* isolate) override;
+  void OnDisposed() override;
+
+ private:
+  SamplingCpuProfiler(v8::Isolate* isolate,
+                      gin::PerIsolateData* per_isolate_data,
+                      base::TimeDelta sampling_interval,
+                      base::TimeDelta window);
+  ~SamplingCpuProfiler() override;
+
+  void StartSegment();
+  void EndSegment();
+
+  // Ends the current segment and starts the next one, dropping the segments
+  // that fell out of the window.
+  void Rotate();
+
+  void Shutdown();
+
+  raw_ptr<gin::PerIsolateData> per_isolate_data_;
+  const base::TimeDelta sampling_interval_;
+  const base::TimeDelta window_;
+
+  raw_ptr<v8::CpuProfiler> profiler_ = nullptr;
+  v8::ProfilerId current_id_ = 0;
+  // Finished segments, oldest first. Together with the current one they
+  // always cover at least |window_|.
+  std::deque<v8::CpuProfile*> segments_;
+  base::RepeatingTimer rotate_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_SAMPLING_CPU_PROFILER_H_
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_timeline.h"
+
+#include <algorithm>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron::startup_timeline {
+
+namespace {
+
+struct Timeline {
+  base::Lock lock;
+  std::vector<Entry> entries GUARDED_BY(lock);
+};
+
+Timeline& GetTimeline() {
+  static base::NoDestructor<Timeline> timeline;
+  return *timeline;
+}
+
+// Appends an entry for |name| starting now, unless one already exists.
+std::optional<size_t> Record(std::string_view name) {
+  Timeline& timeline = GetTimeline();
+  base::AutoLock auto_lock(timeline.lock);
+  if (std::ranges::any_of(timeline.entries, [name](const Entry& entry) {
+        return entry.name == name;
+      })) {
+    return std::nullopt;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  timeline.entries.push_back({std::string(name), now, now});
+  return timeline.entries.size() - 1;
+}
+
+}  // namespace
+
+ScopedPhase::ScopedPhase(std::string_view name) : index_(Record(name)) {
+  if (index_)
+    TRACE_EVENT_BEGIN("electron", perfetto::DynamicString(std::string(name)));
+}
+
+ScopedPhase::~ScopedPhase() {
+  if (!index_)
+    return;
+
+  TRACE_EVENT_END("electron");
+  Timeline& timeline = GetTimeline();
+  base::AutoLock auto_lock(timeline.lock);
+  timeline.entries[*index_].end = base::TimeTicks::Now();
+}
+
+void Mark(std::string_view name) {
+  if (Record(name))
+    TRACE_EVENT_INSTANT("electron", perfetto::DynamicString(std::string(name)));
+}
+
+std::vector<Entry> GetEntries() {
+  Timeline& timeline = GetTimeline();
+  base::AutoLock auto_lock(timeline.lock);
+  return timeline.entries;
+}
+
+}  // namespace electron::startup_timeline
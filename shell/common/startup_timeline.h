@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_STARTUP_TIMELINE_H_
+#define ELECTRON_SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/time/time.h"
+
+// Records when each phase of the browser process's startup happened, so that
+// app.getStartupTimeline() can tell where startup time went. Every phase and
+// mark is recorded only the first time it happens, and is also emitted as a
+// trace event in the "electron" category.
+namespace electron::startup_timeline {
+
+struct Entry {
+  std::string name;
+  base::TimeTicks start;
+  // Equal to |start| for marks.
+  base::TimeTicks end;
+};
+
+// Records the time spent in the current scope as the phase |name|.
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(std::string_view name);
+  ~ScopedPhase();
+
+  // disable copy
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+ private:
+  std::optional<size_t> index_;
+};
+
+// Records that |name| happened now.
+void Mark(std::string_view name);
+
+// Returns the recorded entries, in the order they started.
+std::vector<Entry> GetEntries();
+
+}  // namespace electron::startup_timeline
+
+#endif  // ELECTRON_SHELL_COMMON_STARTUP_TIMELINE_H_
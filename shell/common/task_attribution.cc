@@ -0,0 +1,26 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/task_attribution.h"
+
+#include "base/strings/strcat.h"
+
+namespace electron::task_attribution {
+
+namespace {
+
+constinit thread_local std::string* g_sink = nullptr;
+
+}  // namespace
+
+void Record(std::string_view kind, std::string_view name) {
+  if (g_sink && g_sink->empty())
+    base::StrAppend(g_sink, {kind, ":", name});
+}
+
+void SetSink(std::string* label) {
+  g_sink = label;
+}
+
+}  // namespace electron::task_attribution
@@ -0,0 +1,27 @@
+// Copyright (c) 2025 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_TASK_ATTRIBUTION_H_
+#define ELECTRON_SHELL_COMMON_TASK_ATTRIBUTION_H_
+
+#include <string>
+#include <string_view>
+
+// Tells which Electron event or IPC channel the running task of a thread is
+// dispatching to JS, so that a long task can be blamed on its listeners.
+// Nothing is recorded unless a sink was set on the thread.
+namespace electron::task_attribution {
+
+// Records that the running task dispatches |name|, e.g. an IPC channel, as
+// "<kind>:<name>". Only the first call of each task is kept, since later ones
+// usually come from the listeners of the first.
+void Record(std::string_view kind, std::string_view name);
+
+// Makes Record() store into |label| on the current thread while it's empty.
+// Passing nullptr stops recording.
+void SetSink(std::string* label);
+
+}  // namespace electron::task_attribution
+
+#endif  // ELECTRON_SHELL_COMMON_TASK_ATTRIBUTION_H_
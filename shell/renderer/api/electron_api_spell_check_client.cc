@@ -29,6 +29,13 @@ namespace electron::api {
 
 namespace {
 
+// Maximum number of words whose spelling result is remembered per client.
+constexpr size_t kWordCacheSize = 8192;
+
+// Maximum number of words tokenized per task, so that checking a large text
+// doesn't block input for long.
+constexpr size_t kWordsPerTask = 1000;
+
 bool HasWordCharacters(const std::u16string& text, size_t index) {
   base_icu::UChar32 code;
   while (index < text.size() &&
@@ -52,20 +59,29 @@ struct Word {
 class SpellCheckClient::SpellcheckRequest {
  public:
   SpellcheckRequest(
+      uint64_t id,
       const std::u16string& text,
       std::unique_ptr<blink::WebTextCheckingCompletion> completion)
-      : text_(text), completion_(std::move(completion)) {}
+      : id_(id), text_(text), completion_(std::move(completion)) {}
   SpellcheckRequest(const SpellcheckRequest&) = delete;
   SpellcheckRequest& operator=(const SpellcheckRequest&) = delete;
   ~SpellcheckRequest() = default;
 
+  [[nodiscard]] uint64_t id() const { return id_; }
   [[nodiscard]] const std::u16string& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
   std::vector<Word>& wordlist() { return word_list_; }
+  std::set<std::u16string>& requested_words() { return requested_words_; }
+  std::unordered_set<std::u16string>& misspelled() { return misspelled_; }
 
  private:
+  uint64_t id_;
   std::u16string text_;          // Text to be checked in this task.
   std::vector<Word> word_list_;  // List of Words found in text
+  // Words sent to the JS provider because they were not in the cache.
+  std::set<std::u16string> requested_words_;
+  // Misspelled words of this request, from both the cache and the provider.
+  std::unordered_set<std::u16string> misspelled_;
   // The interface to send the misspelled ranges to Blink.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
 };
@@ -73,7 +89,8 @@ class SpellCheckClient::SpellcheckRequest {
 SpellCheckClient::SpellCheckClient(const std::string& language,
                                    v8::Isolate* isolate,
                                    v8::Local<v8::Object> provider)
-    : isolate_(isolate),
+    : word_cache_(kWordCacheSize),
+      isolate_(isolate),
       context_(isolate, isolate->GetCurrentContext()),
       provider_(isolate, provider) {
   DCHECK(!context_.IsEmpty());
@@ -105,8 +122,8 @@ void SpellCheckClient::RequestCheckingOfText(
     pending_request_param_->completion()->DidCancelCheckingText();
   }
 
-  pending_request_param_ =
-      std::make_unique<SpellcheckRequest>(text, std::move(completionCallback));
+  pending_request_param_ = std::make_unique<SpellcheckRequest>(
+      next_request_id_++, text, std::move(completionCallback));
 
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
       FROM_HERE, base::BindOnce(&SpellCheckClient::SpellCheckText,
@@ -144,15 +161,31 @@ void SpellCheckClient::SpellCheckText() {
   }
 
   text_iterator_.SetText(text);
+  TokenizeText(pending_request_param_->id());
+}
+
+void SpellCheckClient::TokenizeText(uint64_t request_id) {
+  // The request may have been replaced while waiting for this task, in which
+  // case |text_iterator_| already moved on to the new text.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
 
   SpellCheckScope scope(*this);
   std::u16string word;
   size_t word_start;
   size_t word_length;
-  std::set<std::u16string> words;
+  auto& words = pending_request_param_->requested_words();
   auto& word_list = pending_request_param_->wordlist();
   Word word_entry;
-  for (;;) {  // Run until end of text
+  for (size_t count = 0;; ++count) {  // Run until end of text
+    if (count == kWordsPerTask) {
+      // Continue in another task to let input events in.
+      base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE, base::BindOnce(&SpellCheckClient::TokenizeText,
+                                    weak_factory_.GetWeakPtr(), request_id));
+      return;
+    }
+
     const auto status =
         text_iterator_.GetNextWord(&word, &word_start, &word_length);
     if (status == SpellcheckWordIterator::IS_END_OF_TEXT)
@@ -176,16 +209,54 @@ void SpellCheckClient::SpellCheckText() {
     }
   }
 
+  // Only words that have not been checked before need to go to JS.
+  ResolveCachedWords(&words);
+  if (words.empty()) {
+    FinishPendingRequest();
+    return;
+  }
+
   // Send out all the words data to the spellchecker to check
   SpellCheckWords(scope, words);
 }
 
+void SpellCheckClient::ResolveCachedWords(std::set<std::u16string>* words) {
+  auto& misspelled = pending_request_param_->misspelled();
+  for (auto it = words->begin(); it != words->end();) {
+    auto cached = word_cache_.Get(*it);
+    if (cached == word_cache_.end()) {
+      ++it;
+      continue;
+    }
+    if (cached->second)
+      misspelled.insert(*it);
+    it = words->erase(it);
+  }
+}
+
 void SpellCheckClient::OnSpellCheckDone(
+    uint64_t request_id,
     const std::vector<std::u16string>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
-  std::unordered_set<std::u16string> misspelled(misspelled_words.begin(),
-                                                misspelled_words.end());
+  // Ignore results for a request that has since been cancelled or replaced.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
 
+  auto& misspelled = pending_request_param_->misspelled();
+  std::unordered_set<std::u16string> misspelled_in_response(
+      misspelled_words.begin(), misspelled_words.end());
+  for (const auto& word : pending_request_param_->requested_words()) {
+    const bool is_misspelled = misspelled_in_response.contains(word);
+    word_cache_.Put(word, is_misspelled);
+    if (is_misspelled)
+      misspelled.insert(word);
+  }
+
+  FinishPendingRequest();
+}
+
+void SpellCheckClient::FinishPendingRequest() {
+  std::vector<blink::WebTextCheckingResult> results;
+  const auto& misspelled = pending_request_param_->misspelled();
   auto& word_list = pending_request_param_->wordlist();
 
   for (const auto& word : word_list) {
@@ -220,7 +291,8 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
 
   v8::Local<v8::FunctionTemplate> templ = gin_helper::CreateFunctionTemplate(
       isolate_, base::BindRepeating(&SpellCheckClient::OnSpellCheckDone,
-                                    weak_factory_.GetWeakPtr()));
+                                    weak_factory_.GetWeakPtr(),
+                                    pending_request_param_->id()));
   v8::Local<v8::Value> args[] = {gin::ConvertToV8(isolate_, words),
                                  templ->GetFunction(context).ToLocalChecked()};
   // Call javascript with the words and the callback function
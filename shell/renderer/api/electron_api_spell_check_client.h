@@ -5,11 +5,13 @@
 #ifndef ELECTRON_SHELL_RENDERER_API_ELECTRON_API_SPELL_CHECK_CLIENT_H_
 #define ELECTRON_SHELL_RENDERER_API_ELECTRON_API_SPELL_CHECK_CLIENT_H_
 
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "components/spellcheck/renderer/spellcheck_worditerator.h"
@@ -67,12 +69,20 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // request.
   void SpellCheckText();
 
+  // Splits the text of the pending request into words, |kWordsPerTask| at a
+  // time, then sends the words missing from |word_cache_| to JS.
+  void TokenizeText(uint64_t request_id);
+
   // Call JavaScript to check spelling a word.
   // The javascript function will callback OnSpellCheckDone
   // with the results of all the misspelled words.
   void SpellCheckWords(const SpellCheckScope& scope,
                        const std::set<std::u16string>& words);
 
+  // Looks up |words| in |word_cache_|. Words with a known result are removed
+  // from |words| and the misspelled ones are recorded in the pending request.
+  void ResolveCachedWords(std::set<std::u16string>* words);
+
   // Returns whether or not the given word is a contraction of valid words
   // (e.g. "word:word").
   // Output variable contraction_words will contain individual
@@ -82,7 +92,11 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                      std::vector<std::u16string>* contraction_words);
 
   // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<std::u16string>& misspelled_words);
+  void OnSpellCheckDone(uint64_t request_id,
+                        const std::vector<std::u16string>& misspelled_words);
+
+  // Sends the misspelled ranges of the pending request to Blink.
+  void FinishPendingRequest();
 
   // Represents character attributes used for filtering out characters which
   // are not supported by this SpellCheck object.
@@ -101,6 +115,15 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
 
+  // Identifies |pending_request_param_| so that late callbacks from the JS
+  // provider for a cancelled request are ignored.
+  uint64_t next_request_id_ = 0;
+
+  // Results previously returned by the JS provider, keyed by word. The value
+  // is true when the word is misspelled. Typing re-checks the whole paragraph,
+  // so most words of a request are usually already known.
+  base::HashingLRUCache<std::u16string, bool> word_cache_;
+
   raw_ptr<v8::Isolate> isolate_;
   v8::Global<v8::Context> context_;
   v8::Global<v8::Object> provider_;
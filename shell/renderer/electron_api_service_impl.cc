@@ -4,17 +4,22 @@
 
 #include "electron/shell/renderer/electron_api_service_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
+#include "base/functional/callback_helpers.h"
 #include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
+#include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
@@ -29,9 +34,83 @@
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
+#include "third_party/blink/public/web/web_script_source.h"
+#include "v8/include/v8-profiler.h"
 
 namespace electron {
 
+namespace {
+
+// Reports |value| the way content::RenderFrameHost::ExecuteJavaScriptForTests()
+// does for webFrameMain.executeJavaScript(): results that can't be converted,
+// like undefined, succeed with no value and exceptions fail with their message.
+mojom::ScriptResultPtr MakeScriptResult(v8::Isolate* isolate,
+                                        bool success,
+                                        v8::Local<v8::Value> value) {
+  if (!success) {
+    return mojom::ScriptResult::New(
+        false, base::Value(gin::V8ToString(
+                   isolate, v8::Exception::CreateMessage(isolate, value)
+                                ->Get())));
+  }
+  base::Value result;
+  if (!gin::ConvertFromV8(isolate, value, &result))
+    result = base::Value();
+  return mojom::ScriptResult::New(true, std::move(result));
+}
+
+// Runs |source| in the main world of |frame| and awaits the promise it
+// returns, if any.
+void ExecuteJavaScriptInFrame(
+    blink::WebLocalFrame* frame,
+    const blink::WebScriptSource& source,
+    bool user_gesture,
+    base::OnceCallback<void(mojom::ScriptResultPtr)> done) {
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = frame->MainWorldScriptContext();
+  v8::Context::Scope context_scope(context);
+
+  if (user_gesture) {
+    frame->NotifyUserActivation(
+        blink::mojom::UserActivationNotificationType::kInteraction);
+  }
+
+  v8::Local<v8::Value> result;
+  {
+    v8::TryCatch try_catch(isolate);
+    result = frame->ExecuteScriptAndReturnValue(source);
+    if (try_catch.HasCaught()) {
+      std::move(done).Run(
+          MakeScriptResult(isolate, false, try_catch.Exception()));
+      return;
+    }
+  }
+  if (result.IsEmpty() || !result->IsPromise()) {
+    std::move(done).Run(MakeScriptResult(
+        isolate, true,
+        result.IsEmpty() ? v8::Undefined(isolate).As<v8::Value>() : result));
+    return;
+  }
+
+  auto [on_fulfilled, on_rejected] = base::SplitOnceCallback(std::move(done));
+  auto settle = [](base::OnceCallback<void(mojom::ScriptResultPtr)> done,
+                   bool success, v8::Isolate* isolate,
+                   v8::Local<v8::Value> value) {
+    std::move(done).Run(MakeScriptResult(isolate, success, value));
+  };
+  std::ignore = result.As<v8::Promise>()->Then(
+      context,
+      gin::ConvertToV8(isolate, base::BindOnce(settle, std::move(on_fulfilled),
+                                               true, isolate))
+          .As<v8::Function>(),
+      gin::ConvertToV8(isolate, base::BindOnce(settle, std::move(on_rejected),
+                                               false, isolate))
+          .As<v8::Function>());
+}
+
+}  // namespace
+
 ElectronApiServiceImpl::~ElectronApiServiceImpl() = default;
 
 ElectronApiServiceImpl::ElectronApiServiceImpl(
@@ -133,6 +212,7 @@ void ElectronApiServiceImpl::ReceivePostMessage(
 
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    bool compress,
     TakeHeapSnapshotCallback callback) {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   if (!frame)
@@ -140,6 +220,43 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
 
   ScopedAllowBlockingForElectron allow_blocking;
 
+  base::ScopedPlatformFile platform_file;
+  if (mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
+      MOJO_RESULT_OK) {
+    LOG(ERROR) << "Unable to get the file handle from mojo.";
+    std::move(callback).Run(false);
+    return;
+  }
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  electron::StreamHeapSnapshot(isolate, base::File(std::move(platform_file)),
+                               compress, std::move(callback));
+}
+
+void ElectronApiServiceImpl::StartSamplingHeapProfiler(
+    uint64_t sample_interval,
+    int32_t stack_depth,
+    StartSamplingHeapProfilerCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (frame) {
+    v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+    isolate->GetHeapProfiler()->StartSamplingHeapProfiler(sample_interval,
+                                                          stack_depth);
+  }
+  std::move(callback).Run();
+}
+
+void ElectronApiServiceImpl::StopSamplingHeapProfiler(
+    mojo::ScopedHandle file,
+    StopSamplingHeapProfilerCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  ScopedAllowBlockingForElectron allow_blocking;
+
   base::ScopedPlatformFile platform_file;
   if (mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
       MOJO_RESULT_OK) {
@@ -150,9 +267,56 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   base::File base_file(std::move(platform_file));
 
   v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
-  bool success = electron::TakeHeapSnapshot(isolate, &base_file);
+  std::move(callback).Run(
+      electron::StopSamplingHeapProfiler(isolate, &base_file));
+}
 
-  std::move(callback).Run(success);
+void ElectronApiServiceImpl::ExecuteJavaScriptInFrames(
+    const std::u16string& code,
+    bool user_gesture,
+    const std::vector<blink::LocalFrameToken>& frames,
+    ExecuteJavaScriptInFramesCallback callback) {
+  // Scripts finish in any order, so results are tagged with their index.
+  using IndexedResult = std::pair<size_t, mojom::ScriptResultPtr>;
+  auto on_all_done = base::BarrierCallback<IndexedResult>(
+      frames.size(),
+      base::BindOnce(
+          [](ExecuteJavaScriptInFramesCallback callback,
+             std::vector<IndexedResult> indexed_results) {
+            std::ranges::sort(indexed_results, {}, &IndexedResult::first);
+            std::vector<mojom::ScriptResultPtr> results;
+            results.reserve(indexed_results.size());
+            for (auto& [index, result] : indexed_results)
+              results.push_back(std::move(result));
+            std::move(callback).Run(std::move(results));
+          },
+          std::move(callback)));
+
+  const blink::WebScriptSource source(blink::WebString::FromUTF16(code));
+  for (size_t i = 0; i < frames.size(); ++i) {
+    auto on_result = base::BindOnce(
+        [](size_t index, base::OnceCallback<void(IndexedResult)> done,
+           mojom::ScriptResultPtr result) {
+          std::move(done).Run({index, std::move(result)});
+        },
+        i, base::OnceCallback<void(IndexedResult)>(on_all_done));
+    blink::WebLocalFrame* frame =
+        blink::WebLocalFrame::FromFrameToken(frames[i]);
+    if (!frame) {
+      std::move(on_result).Run(mojom::ScriptResult::New(
+          false, base::Value("Render frame was disposed before the script "
+                             "could run")));
+      continue;
+    }
+    ExecuteJavaScriptInFrame(
+        frame, source, user_gesture,
+        // A frame that goes away before the script settles must still reply.
+        mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+            std::move(on_result),
+            mojom::ScriptResult::New(
+                false, base::Value("Render frame was disposed before the "
+                                   "script finished"))));
+  }
 }
 
 }  // namespace electron
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame.h"
@@ -38,7 +39,20 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
+                        bool compress,
                         TakeHeapSnapshotCallback callback) override;
+  void StartSamplingHeapProfiler(
+      uint64_t sample_interval,
+      int32_t stack_depth,
+      StartSamplingHeapProfilerCallback callback) override;
+  void StopSamplingHeapProfiler(
+      mojo::ScopedHandle file,
+      StopSamplingHeapProfilerCallback callback) override;
+  void ExecuteJavaScriptInFrames(
+      const std::u16string& code,
+      bool user_gesture,
+      const std::vector<blink::LocalFrameToken>& frames,
+      ExecuteJavaScriptInFramesCallback callback) override;
   void ProcessPendingMessages();
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
@@ -64,9 +64,34 @@ void ServiceWorkerData::ReceivePostMessage(const std::string& channel,
 }
 
 void ServiceWorkerData::TakeHeapSnapshot(mojo::ScopedHandle file,
+                                         bool compress,
                                          TakeHeapSnapshotCallback callback) {
   NOTIMPLEMENTED();
   std::move(callback).Run(false);
 }
 
+void ServiceWorkerData::StartSamplingHeapProfiler(
+    uint64_t sample_interval,
+    int32_t stack_depth,
+    StartSamplingHeapProfilerCallback callback) {
+  NOTIMPLEMENTED();
+  std::move(callback).Run();
+}
+
+void ServiceWorkerData::StopSamplingHeapProfiler(
+    mojo::ScopedHandle file,
+    StopSamplingHeapProfilerCallback callback) {
+  NOTIMPLEMENTED();
+  std::move(callback).Run(false);
+}
+
+void ServiceWorkerData::ExecuteJavaScriptInFrames(
+    const std::u16string& code,
+    bool user_gesture,
+    const std::vector<blink::LocalFrameToken>& frames,
+    ExecuteJavaScriptInFramesCallback callback) {
+  NOTIMPLEMENTED();
+  std::move(callback).Run({});
+}
+
 }  // namespace electron
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_RENDERER_SERVICE_WORKER_DATA_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -45,7 +46,20 @@ class ServiceWorkerData : public mojom::ElectronRenderer {
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
+                        bool compress,
                         TakeHeapSnapshotCallback callback) override;
+  void StartSamplingHeapProfiler(
+      uint64_t sample_interval,
+      int32_t stack_depth,
+      StartSamplingHeapProfilerCallback callback) override;
+  void StopSamplingHeapProfiler(
+      mojo::ScopedHandle file,
+      StopSamplingHeapProfilerCallback callback) override;
+  void ExecuteJavaScriptInFrames(
+      const std::u16string& code,
+      bool user_gesture,
+      const std::vector<blink::LocalFrameToken>& frames,
+      ExecuteJavaScriptInFramesCallback callback) override;
 
  private:
   void OnElectronRendererRequest(
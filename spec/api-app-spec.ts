@@ -1,4 +1,4 @@
-import { app, BrowserWindow, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
+import { app, BrowserWindow, ipcMain, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
 
 import { assert, expect } from 'chai';
 import * as semver from 'semver';
@@ -1480,6 +1480,92 @@ describe('app module', () => {
     });
   });
 
+  describe('getStartupTimeline() API', () => {
+    afterEach(closeAllWindows);
+
+    it('reports the browser process startup phases in order', () => {
+      const { timeOrigin, entries } = app.getStartupTimeline();
+      expect(timeOrigin).to.be.a('number').and.be.at.most(Date.now());
+      const names = entries.map(entry => entry.name);
+      expect(names).to.include.members([
+        'preEarlyInitialization',
+        'postEarlyInitialization',
+        'createNodeEnvironment',
+        'loadAppCode',
+        'preCreateThreads',
+        'loadResourceBundle',
+        'preMainMessageLoopRun'
+      ]);
+      expect(names.indexOf('createNodeEnvironment')).to.be.lessThan(names.indexOf('loadAppCode'));
+      for (const [i, entry] of entries.entries()) {
+        expect(entry.startTime).to.be.at.least(0);
+        expect(entry.duration).to.be.at.least(0);
+        if (i > 0) expect(entry.startTime).to.be.at.least(entries[i - 1].startTime);
+      }
+    });
+
+    it('records the first renderer launch and paint', async () => {
+      const w = new BrowserWindow({ show: false });
+      const readyToShow = once(w, 'ready-to-show');
+      await w.loadURL('data:text/html,<h1>hello</h1>');
+      await readyToShow;
+      const names = app.getStartupTimeline().entries.map(entry => entry.name);
+      expect(names).to.include.members(['firstRendererLaunch', 'preloadStart', 'preloadEnd', 'firstPaint']);
+    });
+  });
+
+  describe('startJankDetection() API', () => {
+    const block = (ms: number) => {
+      const end = Date.now() + ms;
+      while (Date.now() < end);
+    };
+
+    afterEach(async () => {
+      app.stopJankDetection();
+      await closeAllWindows();
+    });
+
+    it('reports tasks that block the main thread', async () => {
+      app.startJankDetection({ threshold: 100, stackThreshold: 0 });
+      const jank = once(app, 'main-thread-jank');
+      setTimeout(() => block(300));
+      const [, details] = await jank;
+      expect(details.duration).to.be.at.least(300);
+      expect(details.startTime).to.be.at.most(Date.now());
+      expect(details.postedFrom).to.be.a('string').that.is.not.empty();
+      expect(details.stack).to.be.undefined();
+
+      const histogram = app.getJankHistogram();
+      const total = histogram.reduce((sum, bucket) => sum + bucket.count, 0);
+      expect(total).to.be.at.least(1);
+      expect(histogram.find(bucket => bucket.start === 250)!.count).to.be.at.least(1);
+    });
+
+    it('attributes tasks to the IPC channel they dispatch', async () => {
+      app.startJankDetection({ threshold: 100, stackThreshold: 0 });
+      ipcMain.once('jank-channel', () => block(200));
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const jank = once(app, 'main-thread-jank');
+      w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.send(\'jank-channel\')');
+      const [, details] = await jank;
+      expect(details.attribution).to.equal('ipc:jank-channel');
+    });
+
+    it('captures the JavaScript stack of long tasks', async () => {
+      app.startJankDetection({ threshold: 100, stackThreshold: 200 });
+      const jank = once(app, 'main-thread-jank');
+      setTimeout(function blockForJankSpec () { block(600); });
+      const [, details] = await jank;
+      expect(details.stack).to.include('blockForJankSpec');
+    });
+
+    it('throws when already running', () => {
+      app.startJankDetection();
+      expect(() => app.startJankDetection()).to.throw(/already running/);
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
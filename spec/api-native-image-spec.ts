@@ -6,6 +6,15 @@ import * as path from 'node:path';
 
 import { ifdescribe, ifit, itremote, useRemoteContext } from './lib/spec-helpers';
 
+function isTestingBindingAvailable () {
+  try {
+    process._linkedBinding('electron_common_testing');
+    return true;
+  } catch {
+    return false;
+  }
+}
+
 describe('nativeImage module', () => {
   const fixturesPath = path.join(__dirname, 'fixtures');
 
@@ -599,4 +608,53 @@ describe('nativeImage module', () => {
       expect(image.toDataURL({ scaleFactor: 2.0 })).to.equal(imageDataTwo.dataUrl);
     });
   });
+
+  // The testing binding, only available when DCHECK_IS_ON, has a regular
+  // binding of the same method.
+  ifdescribe(isTestingBindingAvailable())('isEmpty() fast API call', () => {
+    let regularIsEmpty: (this: unknown) => boolean;
+    before(() => {
+      regularIsEmpty = process._linkedBinding('electron_common_testing').nativeImageIsEmpty;
+    });
+
+    it('returns the same values as the regular binding of the same method', () => {
+      for (const image of [nativeImage.createFromPath(imageLogo.path), nativeImage.createEmpty()]) {
+        // Enough calls for V8 to optimize the loop and use the fast call.
+        let mismatches = 0;
+        for (let i = 0; i < 1e5; i++) {
+          if (image.isEmpty() !== regularIsEmpty.call(image)) mismatches++;
+        }
+        expect(mismatches).to.equal(0);
+      }
+    });
+
+    it('throws the same errors as the regular binding of the same method', () => {
+      const { isEmpty } = nativeImage.createEmpty();
+      for (const receiver of [{}, null, 42]) {
+        expect(() => isEmpty.call(receiver)).to.throw(TypeError, 'Illegal invocation');
+        expect(() => regularIsEmpty.call(receiver)).to.throw(TypeError, 'Illegal invocation');
+      }
+    });
+
+    it('logs the time of the fast and regular bindings (microbenchmark)', () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+      // Each loop is run twice so that the second run is measured once V8
+      // has optimized it, which is when fast API calls are used.
+      const iterations = 1e6;
+      const time = (loop: () => void) => {
+        loop();
+        const start = performance.now();
+        loop();
+        return (performance.now() - start) * 1e6 / iterations;
+      };
+      const regular = time(() => {
+        for (let i = 0; i < iterations; i++) regularIsEmpty.call(image);
+      });
+      const fast = time(() => {
+        for (let i = 0; i < iterations; i++) image.isEmpty();
+      });
+      // Timings depend too much on the machine to be asserted on.
+      console.log(`regular call: ${regular.toFixed(1)}ns, fast API call: ${fast.toFixed(1)}ns`);
+    });
+  });
 });
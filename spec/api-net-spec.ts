@@ -312,6 +312,32 @@ describe('net module', () => {
         await Promise.all([closePromise, finishPromise]);
       });
 
+      test('should combine small body chunks up to chunkSize', async () => {
+        const chunkSize = 16 * kOneKiloByte;
+        const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+          response.statusCode = 200;
+          for (let i = 0; i < 64; i++) {
+            response.write(randomBuffer(kOneKiloByte));
+            await new Promise(resolve => setImmediate(resolve));
+          }
+          response.end();
+        });
+        const urlRequest = net.request({ url: serverUrl, chunkSize });
+        const response = await getResponse(urlRequest);
+        const chunks: Buffer[] = [];
+        response.on('data', (chunk: Buffer) => chunks.push(chunk));
+        await once(response, 'end');
+        expect(Buffer.concat(chunks).length).to.equal(64 * kOneKiloByte);
+        for (const chunk of chunks.slice(0, -1)) {
+          expect(chunk.length).to.be.at.least(chunkSize);
+        }
+      });
+
+      test('should reject an invalid chunkSize', async () => {
+        expect(() => net.request({ url: 'https://example.com', chunkSize: -1 })).to.throw('chunkSize must be a non-negative integer');
+        expect(() => net.request({ url: 'https://example.com', chunkSize: 2 ** 31 })).to.throw('chunkSize must be a non-negative integer');
+      });
+
       test('should be able to set a custom HTTP request header before first write', async () => {
         const customHeaderName = 'Some-Custom-Header-Name';
         const customHeaderValue = 'Some-Customer-Header-Value';
@@ -102,6 +102,64 @@ describe('process module', () => {
         expect(success).to.be.false();
       });
     });
+
+    describe('process.startCpuProfiling()', () => {
+      afterEach(async () => {
+        await invoke(() => process.stopCpuProfiling());
+      });
+
+      it('writes a .cpuprofile of the window', async () => {
+        const filePath = path.join(app.getPath('temp'), 'test.cpuprofile');
+        defer(() => {
+          try {
+            fs.unlinkSync(filePath);
+          } catch {
+            // ignore error
+          }
+        });
+
+        const success = await invoke(async (filePath: string) => {
+          process.startCpuProfiling({ samplingInterval: 1, windowDuration: 200 });
+          const end = Date.now() + 400;
+          while (Date.now() < end) {
+            await new Promise(resolve => setTimeout(resolve, 10));
+            JSON.stringify(Array.from({ length: 10000 }, (_, i) => i));
+          }
+          return process.writeCpuProfile(filePath);
+        }, filePath);
+        expect(success).to.be.true();
+
+        const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'));
+        expect(profile.nodes[0].callFrame.functionName).to.equal('(root)');
+        expect(profile.nodes.map((node: any) => node.id)).to.deep.equal(profile.nodes.map((_: any, i: number) => i + 1));
+        expect(profile.samples).to.be.an('array').that.is.not.empty();
+        expect(profile.timeDeltas).to.have.lengthOf(profile.samples.length);
+        expect(profile.endTime - profile.startTime).to.be.at.most(200 * 1000);
+        const ids = new Set(profile.nodes.map((node: any) => node.id));
+        for (const id of profile.samples) expect(ids.has(id)).to.be.true();
+      });
+
+      it('throws when already running', async () => {
+        const message = await invoke(() => {
+          process.startCpuProfiling();
+          try {
+            process.startCpuProfiling();
+          } catch (error: any) {
+            return error.message;
+          }
+        });
+        expect(message).to.equal('CPU profiling is already running');
+      });
+
+      it('does not write a profile when stopped', async () => {
+        const success = await invoke((filePath: string) => {
+          process.startCpuProfiling();
+          process.stopCpuProfiling();
+          return process.writeCpuProfile(filePath);
+        }, path.join(app.getPath('temp'), 'unused.cpuprofile'));
+        expect(success).to.be.false();
+      });
+    });
   }
 
   describe('renderer process', () => {
@@ -7,6 +7,7 @@ import * as ChildProcess from 'node:child_process';
 import { EventEmitter, once } from 'node:events';
 import * as fs from 'node:fs';
 import * as http from 'node:http';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import * as qs from 'node:querystring';
 import * as stream from 'node:stream';
@@ -361,6 +362,40 @@ describe('protocol module', () => {
         expect(r.data).to.equal(text);
       });
 
+      it('passes the response through when passthrough is set', async () => {
+        const server = http.createServer((req, res) => {
+          res.setHeader('Access-Control-Allow-Origin', '*');
+          res.setHeader('Access-Control-Expose-Headers', 'x-range');
+          res.setHeader('x-range', req.headers.range ?? '');
+          res.end(text);
+        });
+        defer(() => server.close());
+        const { url } = await listen(server);
+
+        registerHttpProtocol(protocolName, (request, callback) => callback({ url, passthrough: true }));
+        const r = await ajax(protocolName + '://fake-host', { headers: { range: 'bytes=0-3' } });
+        expect(r.data).to.equal(text);
+        expect(r.headers).to.have.property('x-range', 'bytes=0-3');
+      });
+
+      it('follows redirects when passthrough is set', async () => {
+        const server = http.createServer((req, res) => {
+          if (req.url === '/serverRedirect') {
+            res.statusCode = 301;
+            res.setHeader('Location', '/target');
+            res.end();
+          } else {
+            res.end(text);
+          }
+        });
+        defer(() => server.close());
+        const { url } = await listen(server);
+
+        registerHttpProtocol(protocolName, (request, callback) => callback({ url: `${url}/serverRedirect`, passthrough: true }));
+        const r = await ajax(protocolName + '://fake-host');
+        expect(r.data).to.equal(text);
+      });
+
       it('can access request headers', (done) => {
         protocol.registerHttpProtocol(protocolName, (request) => {
           try {
@@ -1122,6 +1157,202 @@ describe('protocol module', () => {
     });
   });
 
+  describe('protocol.mount', () => {
+    const pagesPath = path.join(fixturesPath, 'pages');
+    const asarPath = path.join(fixturesPath, 'test.asar', 'a.asar');
+
+    it('serves files from a directory without a handler', async () => {
+      protocol.mount('http-like', { host: 'bundle', path: pagesPath });
+      defer(() => { protocol.unmount('http-like', 'bundle'); });
+      const resp = await net.fetch('http-like://bundle/a.html');
+      expect(resp.status).to.equal(200);
+      expect(resp.headers.get('content-type')).to.match(/^text\/html/);
+      expect(await resp.text()).to.equal(fs.readFileSync(path.join(pagesPath, 'a.html'), 'utf8'));
+    });
+
+    it('serves files from an asar archive', async () => {
+      protocol.mount('http-like', { path: asarPath });
+      defer(() => { protocol.unmount('http-like'); });
+      const body = await net.fetch('http-like://any-host/file1').then(r => r.text());
+      expect(body).to.equal(fs.readFileSync(path.join(asarPath, 'file1'), 'utf8'));
+    });
+
+    it('adds static headers and an ETag', async () => {
+      protocol.mount('http-like', { path: pagesPath, headers: { 'x-mounted': 'yes' } });
+      defer(() => { protocol.unmount('http-like'); });
+      const resp = await net.fetch('http-like://bundle/a.html');
+      expect(resp.headers.get('x-mounted')).to.equal('yes');
+      const etag = resp.headers.get('etag');
+      expect(etag).to.be.a('string');
+      const cached = await net.fetch('http-like://bundle/a.html', { headers: { 'if-none-match': etag! } });
+      expect(cached.status).to.equal(304);
+    });
+
+    it('passes misses to the handler', async () => {
+      protocol.mount('http-like', { path: pagesPath });
+      protocol.handle('http-like', (req) => new Response('dynamic ' + new URL(req.url).pathname));
+      defer(() => {
+        protocol.unmount('http-like');
+        protocol.unhandle('http-like');
+      });
+      const hit = await net.fetch('http-like://bundle/a.html').then(r => r.text());
+      expect(hit).to.equal(fs.readFileSync(path.join(pagesPath, 'a.html'), 'utf8'));
+      const miss = await net.fetch('http-like://bundle/api/users').then(r => r.text());
+      expect(miss).to.equal('dynamic /api/users');
+    });
+
+    it('does not serve files outside of the mounted directory', async () => {
+      protocol.mount('http-like', { path: pagesPath });
+      defer(() => { protocol.unmount('http-like'); });
+      await expect(net.fetch('http-like://bundle/..%2f..%2fapi-protocol-spec.ts')).to.eventually.be.rejectedWith(/ERR_FILE_NOT_FOUND/);
+    });
+
+    ifit(process.platform !== 'win32')('does not follow symbolic links out of the mounted directory', async () => {
+      const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-mount-'));
+      const mountPath = path.join(tmpDir, 'mount');
+      fs.mkdirSync(mountPath);
+      fs.writeFileSync(path.join(mountPath, 'inside.txt'), 'inside');
+      fs.writeFileSync(path.join(tmpDir, 'outside.txt'), 'outside');
+      fs.symlinkSync('inside.txt', path.join(mountPath, 'link-inside.txt'));
+      fs.symlinkSync(path.join(tmpDir, 'outside.txt'), path.join(mountPath, 'link-outside.txt'));
+      protocol.mount('http-like', { path: mountPath });
+      defer(() => {
+        protocol.unmount('http-like');
+        fs.rmSync(tmpDir, { recursive: true, force: true });
+      });
+      expect(await net.fetch('http-like://bundle/link-inside.txt').then(r => r.text())).to.equal('inside');
+      await expect(net.fetch('http-like://bundle/link-outside.txt')).to.eventually.be.rejectedWith(/ERR_FILE_NOT_FOUND/);
+    });
+
+    it('rejects invalid options', () => {
+      expect(() => protocol.mount('http-like', { path: 'relative' })).to.throw(/absolute path/);
+      expect(() => protocol.mount('https', { path: pagesPath })).to.throw(/built-in schemes/);
+      expect(() => protocol.unmount('http-like', 'nothing')).to.throw(/No directory is mounted/);
+    });
+  });
+
+  describe('protocol.enableResponseCache', () => {
+    afterEach(() => {
+      try { protocol.disableResponseCache('test-scheme'); } catch { /* ignore */ }
+      try { protocol.unhandle('test-scheme'); } catch { /* ignore */ }
+    });
+
+    it('serves fresh responses without calling the handler', async () => {
+      let calls = 0;
+      protocol.enableResponseCache('test-scheme');
+      protocol.handle('test-scheme', () => {
+        calls++;
+        return new Response('cached', { headers: { 'cache-control': 'max-age=60' } });
+      });
+      for (let i = 0; i < 3; i++) {
+        const body = await net.fetch('test-scheme://foo/asset.js').then(r => r.text());
+        expect(body).to.equal('cached');
+      }
+      expect(calls).to.equal(1);
+      const stats = protocol.getResponseCacheStats('test-scheme')!;
+      expect(stats.hits).to.equal(2);
+      expect(stats.misses).to.equal(1);
+      expect(stats.hitRate).to.be.closeTo(2 / 3, 0.001);
+      expect(stats.entryCount).to.equal(1);
+    });
+
+    it('does not cache no-store responses', async () => {
+      let calls = 0;
+      protocol.enableResponseCache('test-scheme');
+      protocol.handle('test-scheme', () => {
+        calls++;
+        return new Response('fresh', { headers: { 'cache-control': 'no-store' } });
+      });
+      await net.fetch('test-scheme://foo/a').then(r => r.text());
+      await net.fetch('test-scheme://foo/a').then(r => r.text());
+      expect(calls).to.equal(2);
+      expect(protocol.getResponseCacheStats('test-scheme')!.entryCount).to.equal(0);
+    });
+
+    it('revalidates stale responses with their ETag', async () => {
+      const conditions: (string | null)[] = [];
+      protocol.enableResponseCache('test-scheme');
+      protocol.handle('test-scheme', (req) => {
+        conditions.push(req.headers.get('if-none-match'));
+        if (req.headers.get('if-none-match') === '"v1"') {
+          return new Response(null, { status: 304 });
+        }
+        return new Response('body v1', { headers: { 'cache-control': 'no-cache', etag: '"v1"' } });
+      });
+      expect(await net.fetch('test-scheme://foo/b').then(r => r.text())).to.equal('body v1');
+      expect(await net.fetch('test-scheme://foo/b').then(r => r.text())).to.equal('body v1');
+      expect(conditions).to.deep.equal([null, '"v1"']);
+      expect(protocol.getResponseCacheStats('test-scheme')!.revalidations).to.equal(1);
+    });
+
+    it('keys entries by the Vary request headers', async () => {
+      let calls = 0;
+      protocol.enableResponseCache('test-scheme');
+      protocol.handle('test-scheme', (req) => {
+        calls++;
+        return new Response(req.headers.get('x-lang'), { headers: { 'cache-control': 'max-age=60', vary: 'x-lang' } });
+      });
+      const fetchWith = (lang: string) => net.fetch('test-scheme://foo/c', { headers: { 'x-lang': lang } }).then(r => r.text());
+      expect(await fetchWith('en')).to.equal('en');
+      expect(await fetchWith('fr')).to.equal('fr');
+      expect(await fetchWith('fr')).to.equal('fr');
+      expect(await fetchWith('en')).to.equal('en');
+      expect(calls).to.equal(2);
+      expect(protocol.getResponseCacheStats('test-scheme')!.entryCount).to.equal(2);
+    });
+
+    it('does not serve the cached body for a 304 about another ETag', async () => {
+      const conditions: (string | null)[] = [];
+      let version = 1;
+      protocol.enableResponseCache('test-scheme');
+      protocol.handle('test-scheme', (req) => {
+        conditions.push(req.headers.get('if-none-match'));
+        if (req.headers.get('if-none-match')) {
+          return new Response(null, { status: 304, headers: { etag: `"v${version}"` } });
+        }
+        return new Response(`body v${version}`, { headers: { 'cache-control': 'no-cache', etag: `"v${version}"` } });
+      });
+      expect(await net.fetch('test-scheme://foo/d').then(r => r.text())).to.equal('body v1');
+      version = 2;
+      expect(await net.fetch('test-scheme://foo/d').then(r => r.text())).to.equal('body v2');
+      expect(conditions).to.deep.equal([null, '"v1"', null]);
+      expect(protocol.getResponseCacheStats('test-scheme')!.revalidations).to.equal(0);
+    });
+
+    it('streams bodies larger than the cache without caching them', async () => {
+      protocol.enableResponseCache('test-scheme', { maxSize: 1024 });
+      protocol.handle('test-scheme', () => {
+        const chunk = new Uint8Array(512).fill(0x61);
+        let remaining = 8;
+        const body = new ReadableStream({
+          pull (controller) {
+            if (remaining-- > 0) controller.enqueue(chunk);
+            else controller.close();
+          }
+        });
+        return new Response(body, { headers: { 'cache-control': 'max-age=60' } });
+      });
+      const body = await net.fetch('test-scheme://foo/large').then(r => r.text());
+      expect(body).to.equal('a'.repeat(8 * 512));
+      expect(protocol.getResponseCacheStats('test-scheme')!.entryCount).to.equal(0);
+    });
+
+    it('evicts the least recently used responses', async () => {
+      protocol.enableResponseCache('test-scheme', { maxSize: 1024 });
+      protocol.handle('test-scheme', () => new Response('x'.repeat(400), { headers: { 'cache-control': 'max-age=60' } }));
+      for (const name of ['a', 'b', 'c']) {
+        await net.fetch(`test-scheme://foo/${name}`).then(r => r.text());
+      }
+      const stats = protocol.getResponseCacheStats('test-scheme')!;
+      expect(stats.entryCount).to.equal(2);
+      expect(stats.size).to.be.at.most(1024);
+    });
+
+    it('returns null stats when the cache is not enabled', () => {
+      expect(protocol.getResponseCacheStats('test-scheme')).to.be.null();
+    });
+  });
+
   describe('handle', () => {
     afterEach(closeAllWindows);
 
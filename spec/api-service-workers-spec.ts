@@ -8,7 +8,7 @@ import * as fs from 'node:fs';
 import * as http from 'node:http';
 import * as path from 'node:path';
 
-import { listen } from './lib/spec-helpers';
+import { defer, listen } from './lib/spec-helpers';
 
 const partition = 'service-workers-spec';
 
@@ -60,6 +60,22 @@ describe('session.serviceWorkers', () => {
       const ids = Object.keys(workers) as any[] as number[];
       expect(ids).to.have.lengthOf(1, 'should have one worker running');
     });
+
+    it('should run the worker in the process of the page that registered it', async () => {
+      w.loadURL(`${baseUrl}/index.html`);
+      await once(ses.serviceWorkers, 'console-message');
+      const [worker] = Object.values(ses.serviceWorkers.getAllRunning());
+      expect(worker.renderProcessId).to.equal(w.getProcessId());
+    });
+
+    it('should still run the worker in the page process with process-per-site origins', async () => {
+      ses.setProcessPerSiteOrigins([new URL(baseUrl).origin]);
+      defer(() => ses.setProcessPerSiteOrigins([]));
+      w.loadURL(`${baseUrl}/index.html`);
+      await once(ses.serviceWorkers, 'console-message');
+      const [worker] = Object.values(ses.serviceWorkers.getAllRunning());
+      expect(worker.renderProcessId).to.equal(w.getProcessId());
+    });
   });
 
   describe('getFromVersionID()', () => {
@@ -9,12 +9,16 @@ import { once } from 'node:events';
 import * as fs from 'node:fs';
 import * as http from 'node:http';
 import * as https from 'node:https';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import { setTimeout } from 'node:timers/promises';
 
-import { defer, ifit, listen } from './lib/spec-helpers';
+import { randomString } from './lib/net-helpers';
+import { defer, ifit, listen, waitUntil } from './lib/spec-helpers';
 import { closeAllWindows } from './lib/window-helpers';
 
+const features = process._linkedBinding('electron_common_features');
+
 describe('session module', () => {
   const fixtures = path.resolve(__dirname, 'fixtures');
   const url = 'http://127.0.0.1';
@@ -29,6 +33,61 @@ describe('session module', () => {
     it('returns existing session with same partition', () => {
       expect(session.fromPartition('test')).to.equal(session.fromPartition('test'));
     });
+
+    it('appends preference changes to a log with the log preferences store', async () => {
+      const ses = session.fromPartition(`persist:${randomString(10)}`, { preferencesStore: 'log' });
+      expect(ses.getPreferencesStoreMetrics()).to.deep.include({ writeCount: 0, compactionCount: 0 });
+      expect(session.defaultSession.getPreferencesStoreMetrics()).to.be.null();
+
+      const downloadPath = path.join(app.getPath('temp'), 'preferences-store-downloads');
+      ses.setDownloadPath(downloadPath);
+      await waitUntil(() => ses.getPreferencesStoreMetrics()!.writeCount > 0);
+      const metrics = ses.getPreferencesStoreMetrics()!;
+      expect(metrics.writeBytes).to.be.greaterThan(0);
+      expect(metrics.writeTime).to.be.at.least(0);
+      expect(metrics.compactionCount).to.equal(0);
+
+      const log = fs.readFileSync(path.join(ses.storagePath!, 'Preferences.log'), 'utf8');
+      const records = log.trim().split('\n').map(line => JSON.parse(line));
+      expect(records).to.deep.include({ key: 'download.default_directory', value: downloadPath });
+    });
+
+    ifit(features.isBuiltinSpellCheckerEnabled())('keeps preferences across restarts with either store', async function () {
+      this.timeout(60000);
+      const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-preferences-store-'));
+      defer(() => fs.rmSync(userData, { recursive: true, force: true }));
+      const logPath = path.join(userData, 'Partitions', 'preferences-store', 'Preferences.log');
+
+      const runApp = async (phase: string, store: string) => {
+        const appProcess = ChildProcess.spawn(process.execPath, [path.join(fixtures, 'api', 'preferences-store-app')], {
+          env: {
+            ...process.env,
+            PHASE: phase,
+            STORE: store,
+            USER_DATA: userData,
+            IN_MEMORY_DOWNLOAD_PATH: path.join(userData, 'in-memory-downloads')
+          }
+        });
+        let output = '';
+        appProcess.stdout.on('data', data => { output += data; });
+        const [code] = await once(appProcess, 'exit');
+        expect(code).to.equal(0);
+        return output;
+      };
+
+      await runApp('write', 'log');
+      expect(fs.existsSync(logPath)).to.be.true();
+      // In-memory sessions never write to the default session's Preferences.
+      expect(fs.readFileSync(path.join(userData, 'Preferences'), 'utf8')).to.not.include('in-memory-downloads');
+
+      // In-memory sessions start from the default session's preferences.
+      const expected = { defaultSession: false, logSession: false, inMemorySession: false };
+      expect(JSON.parse(await runApp('read', 'log'))).to.deep.equal(expected);
+
+      // Switching back to the json store folds the log into Preferences.
+      expect(JSON.parse(await runApp('read', 'json'))).to.deep.equal(expected);
+      expect(fs.existsSync(logPath)).to.be.false();
+    });
   });
 
   describe('session.fromPath(path)', () => {
@@ -129,6 +188,66 @@ describe('session module', () => {
       expect(cs.some(c => c.name === name && c.value === value)).to.equal(true);
     });
 
+    it('limits the number of cookies returned', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.set({ url, name: 'a', value: '1' });
+      await cookies.set({ url, name: 'b', value: '2' });
+      const cs = await cookies.get({ domain: '127.0.0.1', limit: 1 });
+      expect(cs).to.have.lengthOf(1);
+    });
+
+    it('pages through cookies with offset and limit', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.set({ url, name: 'a', value: '1' });
+      await cookies.set({ url, name: 'b', value: '2' });
+      const all = await cookies.get({ domain: '127.0.0.1' });
+      const pages = [];
+      for (let offset = 0; offset < all.length; offset++) {
+        pages.push(...await cookies.get({ domain: '127.0.0.1', offset, limit: 1 }));
+      }
+      expect(pages).to.deep.equal(all);
+      expect(await cookies.get({ domain: '127.0.0.1', offset: all.length })).to.be.empty();
+    });
+
+    it('sets many cookies at once', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.setMany([
+        { url, name: 'many1', value: '1' },
+        { url, name: 'many2', value: '2' }
+      ]);
+      const cs = await cookies.get({ url });
+      expect(cs.map(c => c.name)).to.include.members(['many1', 'many2']);
+    });
+
+    it('does not set any cookie when one of many is invalid', async () => {
+      const { cookies } = session.defaultSession;
+      await expect(cookies.setMany([
+        { url, name: 'valid', value: '1' },
+        { url, name: 'invalid', value: '1', sameSite: 'garbage' as any }
+      ])).to.eventually.be.rejectedWith('Failed to convert \'garbage\' to an appropriate cookie same site value');
+      const cs = await cookies.get({ url, name: 'valid' });
+      expect(cs).to.be.empty();
+    });
+
+    it('removes matching cookies in one call', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.set({ url, name: 'removed', value: '1' });
+      await cookies.set({ url, name: 'kept', value: '1' });
+      const removed = await cookies.removeMatching({ url, name: 'removed' });
+      expect(removed).to.equal(1);
+      const cs = await cookies.get({ url });
+      expect(cs.map(c => c.name)).to.deep.equal(['kept']);
+    });
+
+    it('refuses to remove cookies without a known criterion', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.set({ url, name: 'kept', value: '1' });
+      await expect(cookies.removeMatching({})).to.eventually.be.rejectedWith(/at least one/);
+      await expect(cookies.removeMatching({ nmae: 'kept' } as any)).to.eventually.be.rejectedWith('Unknown filter property \'nmae\'');
+      const cs = await cookies.get({ url });
+      expect(cs.map(c => c.name)).to.include('kept');
+    });
+
     it('rejects when setting a cookie with missing required fields', async () => {
       const { cookies } = session.defaultSession;
       const name = '1';
@@ -905,12 +1024,23 @@ describe('session module', () => {
     let downloadServer: http.Server;
 
     before(async () => {
-      downloadServer = http.createServer((req, res) => {
+      downloadServer = http.createServer(async (req, res) => {
         res.writeHead(200, {
           'Content-Length': mockPDF.length,
           'Content-Type': 'application/pdf',
           'Content-Disposition': req.url === '/?testFilename' ? 'inline' : contentDisposition
         });
+        if (req.url === '/?slow') {
+          // Spread the body over a couple of seconds, so that the download
+          // reports its progress several times.
+          const chunkSize = mockPDF.length / 20;
+          for (let offset = 0; offset < mockPDF.length; offset += chunkSize) {
+            res.write(mockPDF.subarray(offset, offset + chunkSize));
+            await setTimeout(100);
+          }
+          res.end();
+          return;
+        }
         res.end(mockPDF);
       });
       port = (await listen(downloadServer)).port;
@@ -1013,6 +1143,34 @@ describe('session module', () => {
         expect(end).to.be.greaterThan(start);
       });
 
+      it('coalesces progress updates when an update interval is set', async () => {
+        const willDownload = once(session.defaultSession, 'will-download');
+        session.defaultSession.downloadURL(`${url}:${port}/?slow`);
+        const [, item] = await willDownload;
+        item.savePath = downloadFilePath;
+        item.setUpdateInterval(60 * 1000);
+        expect(item.getUpdateInterval()).to.equal(60 * 1000);
+
+        const updates: { receivedBytes: number, deltaBytes: number, bytesPerSecond: number }[] = [];
+        item.on('updated', (event, state, progress) => {
+          updates.push(progress);
+        });
+        const [, state] = await once(item, 'done');
+        expect(state).to.equal('completed');
+        expect(item.getReceivedBytes()).to.equal(mockPDF.length);
+        fs.unlinkSync(downloadFilePath);
+
+        // The first update is emitted right away, and the download is done
+        // well before the interval elapses again.
+        expect(updates).to.have.length.within(1, 2);
+        let receivedBytes = 0;
+        for (const progress of updates) {
+          expect(progress.bytesPerSecond).to.be.a('number').that.is.at.least(0);
+          receivedBytes += progress.deltaBytes;
+          expect(progress.receivedBytes).to.equal(receivedBytes);
+        }
+      });
+
       it('throws when called with invalid headers', () => {
         expect(() => {
           session.defaultSession.downloadURL(`${url}:${port}`, {
@@ -1612,6 +1770,51 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setProcessPerSiteOrigins()', () => {
+    afterEach(closeAllWindows);
+
+    it('can be retrieved with getProcessPerSiteOrigins()', () => {
+      const ses = session.fromPartition('' + Math.random());
+      ses.setProcessPerSiteOrigins(['https://app.example.com']);
+      expect(ses.getProcessPerSiteOrigins()).to.deep.equal(['https://example.com/']);
+    });
+
+    it('throws for an invalid origin', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(() => ses.setProcessPerSiteOrigins(['not a url'])).to.throw(/Invalid origin/);
+    });
+
+    it('makes windows of the same site share a renderer process', async () => {
+      const server = http.createServer((req, res) => res.end('hello'));
+      const { url } = await listen(server);
+      defer(() => server.close());
+
+      const ses = session.fromPartition('' + Math.random());
+      ses.setProcessPerSiteOrigins([url]);
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w1.loadURL(url);
+      await w2.loadURL(url);
+      expect(w1.webContents.getOSProcessId()).to.equal(w2.webContents.getOSProcessId());
+    });
+
+    it('does not share a renderer process between different webPreferences', async () => {
+      const server = http.createServer((req, res) => res.end('hello'));
+      const { url } = await listen(server);
+      defer(() => server.close());
+
+      const ses = session.fromPartition('' + Math.random());
+      ses.setProcessPerSiteOrigins([url]);
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: false, nodeIntegration: true } });
+      await w1.loadURL(url);
+      await w2.loadURL(url);
+      expect(w1.webContents.getOSProcessId()).to.not.equal(w2.webContents.getOSProcessId());
+      expect(await w1.webContents.executeJavaScript('typeof require')).to.equal('undefined');
+      expect(await w2.webContents.executeJavaScript('typeof require')).to.equal('function');
+    });
+  });
+
   describe('session-created event', () => {
     it('is emitted when a session is created', async () => {
       const sessionCreated = once(app, 'session-created') as Promise<[any, Session]>;
@@ -1653,6 +1856,44 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setConsoleLogSink()', () => {
+    afterEach(closeAllWindows);
+
+    it('throws without an absolute path', () => {
+      const ses = session.fromPartition('' + Math.random());
+      expect(() => ses.setConsoleLogSink({ path: 'relative.log' })).to.throw(/Absolute path/);
+      expect(() => ses.setConsoleLogSink({ path: path.join(app.getPath('temp'), 'a.log'), levels: ['trace' as any] })).to.throw(/levels/);
+    });
+
+    it('writes matching console messages as JSON lines', async () => {
+      const logPath = path.join(app.getPath('temp'), `console-sink-${Math.random()}.log`);
+      defer(() => fs.rmSync(logPath, { force: true }));
+      const ses = session.fromPartition('' + Math.random());
+      ses.setConsoleLogSink({ path: logPath, levels: ['warning', 'error'], flushInterval: 0 });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      let emitted = 0;
+      w.webContents.on('console-message', () => { emitted++; });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript('console.log("a"); console.warn("b"); console.error("c")');
+
+      // Console messages arrive separately from the result of
+      // executeJavaScript(), so wait for them before removing the sink.
+      let lines: any[] = [];
+      await waitUntil(() => {
+        if (fs.existsSync(logPath)) {
+          lines = fs.readFileSync(logPath, 'utf8').split('\n').filter(Boolean).map(line => JSON.parse(line));
+        }
+        return lines.length >= 2;
+      });
+      ses.setConsoleLogSink(null);
+      expect(lines.map(({ level, message }) => [level, message])).to.deep.equal([['warning', 'b'], ['error', 'c']]);
+      expect(lines[0].webContentsId).to.equal(w.webContents.id);
+      expect(lines[0].time).to.be.a('number');
+      expect(emitted).to.equal(1);
+    });
+  });
+
   describe('ses.setSSLConfig()', () => {
     it('can disable cipher suites', async () => {
       const ses = session.fromPartition('' + Math.random());
@@ -572,6 +572,27 @@ describe('utilityProcess module', () => {
       await exit;
     });
 
+    it('can write a CPU profile with process.writeCpuProfile()', async () => {
+      const filePath = path.join(app.getPath('temp'), `utility-${randomString(8)}.cpuprofile`);
+      const child = utilityProcess.fork(path.join(fixturesPath, 'cpu-profile.js'), [], {
+        stdio: 'ignore'
+      });
+      await once(child, 'spawn');
+      child.postMessage(filePath);
+      const [success] = await once(child, 'message');
+      expect(success).to.be.true();
+      const profile = JSON.parse(await fs.readFile(filePath, 'utf8'));
+      await fs.rm(filePath, { force: true });
+      expect(profile.nodes[0].id).to.equal(1);
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+      const ids = new Set(profile.nodes.map((node: any) => node.id));
+      for (const id of profile.samples) expect(ids.has(id)).to.be.true();
+      // Cleanup.
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
     it('should emit the app#login event when 401', async () => {
       const { remotely } = await startRemoteControlApp();
       const serverUrl = await respondOnce.toSingleURL((request, response) => {
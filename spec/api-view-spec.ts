@@ -92,4 +92,77 @@ describe('View', () => {
       expect(v.getVisible()).to.be.false();
     });
   });
+
+  describe('view.batchUpdate()', () => {
+    it('applies bounds, visibility and order changes', () => {
+      w = new BaseWindow({ show: false });
+      const v1 = new View();
+      const v2 = new View();
+      w.contentView.addChildView(v1);
+      w.contentView.addChildView(v2);
+
+      w.contentView.batchUpdate([
+        { view: v1, bounds: { x: 0, y: 0, width: 100, height: 100 }, index: 1 },
+        { view: v2, bounds: { x: 100, y: 0, width: 50, height: 50 }, visible: false }
+      ]);
+
+      expect(v1.getBounds()).to.deep.equal({ x: 0, y: 0, width: 100, height: 100 });
+      expect(v2.getBounds()).to.deep.equal({ x: 100, y: 0, width: 50, height: 50 });
+      expect(v2.getVisible()).to.be.false();
+      expect(w.contentView.children).to.deep.equal([v2, v1]);
+    });
+
+    it('emits bounds-changed once per view after all updates are applied', () => {
+      w = new BaseWindow({ show: false });
+      const v1 = new View();
+      const v2 = new View();
+      w.contentView.addChildView(v1);
+      w.contentView.addChildView(v2);
+
+      const seen: Electron.Rectangle[] = [];
+      v1.on('bounds-changed', () => { seen.push(v2.getBounds()); });
+      w.contentView.batchUpdate([
+        { view: v1, bounds: { x: 0, y: 0, width: 10, height: 10 } },
+        { view: v1, bounds: { x: 0, y: 0, width: 20, height: 20 } },
+        { view: v2, bounds: { x: 20, y: 0, width: 20, height: 20 } }
+      ]);
+
+      expect(seen).to.deep.equal([{ x: 20, y: 0, width: 20, height: 20 }]);
+    });
+
+    it('throws without applying anything when a view is not a child', () => {
+      w = new BaseWindow({ show: false });
+      const v1 = new View();
+      w.contentView.addChildView(v1);
+
+      expect(() => {
+        w.contentView.batchUpdate([
+          { view: v1, bounds: { x: 0, y: 0, width: 10, height: 10 } },
+          { view: new View(), bounds: { x: 0, y: 0, width: 10, height: 10 } }
+        ]);
+      }).to.throw('Each updated view must be a child of this view');
+      expect(v1.getBounds()).to.deep.equal({ x: 0, y: 0, width: 0, height: 0 });
+    });
+
+    it('throws without applying anything when a field has the wrong type', () => {
+      w = new BaseWindow({ show: false });
+      const v1 = new View();
+      const v2 = new View();
+      w.contentView.addChildView(v1);
+      w.contentView.addChildView(v2);
+
+      const bounds = { x: 0, y: 0, width: 10, height: 10 };
+      expect(() => {
+        w.contentView.batchUpdate([{ view: v1, bounds }, { view: v2, visible: 'no' as any }]);
+      }).to.throw(/'visible' must be a boolean/);
+      expect(() => {
+        w.contentView.batchUpdate([{ view: v1, bounds }, { view: v2, index: 'first' as any }]);
+      }).to.throw(/'index' must be a non-negative integer/);
+      expect(() => {
+        w.contentView.batchUpdate([{ view: v1, bounds }, { view: v2, bounds: 'full' as any }]);
+      }).to.throw(/'bounds' must be a Rectangle/);
+      expect(v1.getBounds()).to.deep.equal({ x: 0, y: 0, width: 0, height: 0 });
+      expect(w.contentView.children).to.deep.equal([v1, v2]);
+    });
+  });
 });
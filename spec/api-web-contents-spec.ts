@@ -11,6 +11,7 @@ import * as os from 'node:os';
 import * as path from 'node:path';
 import { setTimeout } from 'node:timers/promises';
 import * as url from 'node:url';
+import * as zlib from 'node:zlib';
 
 import { ifdescribe, defer, waitUntil, listen, ifit } from './lib/spec-helpers';
 import { cleanupWebContents, closeAllWindows } from './lib/window-helpers';
@@ -85,6 +86,42 @@ describe('webContents module', () => {
     });
   });
 
+  describe('prewarm() / takeSpare()', () => {
+    const webPreferences = { sandbox: true, backgroundThrottling: false };
+    afterEach(async () => {
+      webContents.prewarm(webPreferences, 0);
+      await cleanupWebContents();
+    });
+
+    it('hands out a warm spare and counts hits and misses', async () => {
+      const before = webContents.getSpareStats();
+      const existing = new Set(webContents.getAllWebContents());
+      webContents.prewarm(webPreferences, 1);
+      const [warming] = webContents.getAllWebContents().filter(contents => !existing.has(contents));
+      if (warming.isLoading()) await once(warming, 'did-finish-load');
+
+      const spare = webContents.takeSpare({ backgroundThrottling: false, sandbox: true });
+      expect(spare).to.equal(warming);
+      // Its renderer process was launched before it was taken, and is reused.
+      const pid = spare.getOSProcessId();
+      expect(pid).to.be.above(0);
+      await spare.loadURL('data:text/html,hello');
+      expect(spare.getURL()).to.equal('data:text/html,hello');
+      expect(spare.getOSProcessId()).to.equal(pid);
+
+      const other = webContents.takeSpare({ sandbox: false });
+      expect(other).to.not.equal(spare);
+
+      const after = webContents.getSpareStats();
+      expect(after.hits - before.hits).to.equal(1);
+      expect(after.misses - before.misses).to.equal(1);
+    });
+
+    it('rejects an invalid count', () => {
+      expect(() => webContents.prewarm(webPreferences, -1)).to.throw(/count/);
+    });
+  });
+
   describe('fromDevToolsTargetId()', () => {
     afterEach(closeAllWindows);
     it('returns WebContents for attached DevTools target', async () => {
@@ -1010,6 +1047,49 @@ describe('webContents module', () => {
       await devtoolsOpened2;
       expect(w.webContents.isDevToolsOpened()).to.be.true();
     });
+
+    it('delivers large protocol messages in chunks, in order', async function () {
+      this.timeout(60000);
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const devtoolsOpened = once(w.webContents, 'devtools-opened');
+      w.webContents.openDevTools({ mode: 'detach', activate: false });
+      await devtoolsOpened;
+
+      // Record what the frontend receives from the protocol.
+      const devtools = w.webContents.devToolsWebContents!;
+      await waitUntil(() => devtools.executeJavaScript('typeof DevToolsAPI === \'object\''));
+      await devtools.executeJavaScript(`{
+        globalThis.received = [];
+        const { dispatchMessage, dispatchMessageChunk } = DevToolsAPI;
+        DevToolsAPI.dispatchMessage = function (message) {
+          received.push({ length: message.length, marker: /after-large-message|ready-marker/.exec(message)?.[0] });
+          return dispatchMessage.apply(this, arguments);
+        };
+        DevToolsAPI.dispatchMessageChunk = function (chunk, totalSize) {
+          received.push({ length: chunk.length, totalSize: Number(totalSize) });
+          return dispatchMessageChunk.apply(this, arguments);
+        };
+      }`);
+      await waitUntil(async () => {
+        await w.webContents.executeJavaScript('console.log(\'ready-marker\')');
+        return devtools.executeJavaScript('received.some(m => m.marker === \'ready-marker\')');
+      });
+
+      // Larger than a chunk, which is a quarter of the maximum IPC message size.
+      const size = 40 * 1024 * 1024;
+      await w.webContents.executeJavaScript(`console.log('x'.repeat(${size})); console.log('after-large-message')`);
+      await waitUntil(() => devtools.executeJavaScript('received.some(m => m.marker === \'after-large-message\')'), { timeout: 30000 });
+
+      const received: { length: number, totalSize?: number, marker?: string }[] = await devtools.executeJavaScript('received');
+      const chunks = received.filter(m => m.totalSize !== undefined);
+      expect(chunks).to.have.length.above(1);
+      expect(chunks[0].totalSize).to.be.above(size);
+      expect(chunks.slice(1).every(chunk => chunk.totalSize === 0)).to.be.true();
+      expect(chunks.reduce((sum, chunk) => sum + chunk.length, 0)).to.equal(chunks[0].totalSize);
+      const lastChunk = received.lastIndexOf(chunks[chunks.length - 1]);
+      expect(received.findIndex(m => m.marker === 'after-large-message')).to.be.above(lastChunk);
+    });
   });
 
   describe('setDevToolsTitle() API', () => {
@@ -2080,6 +2160,36 @@ describe('webContents module', () => {
     }
   });
 
+  describe('fast API accessors', () => {
+    afterEach(closeAllWindows);
+
+    // Enough calls for V8 to optimize the loop below, which is when fast API
+    // calls are used.
+    const iterations = 1e6;
+
+    it('return the same values as the regular path when optimized', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const contents = w.webContents;
+      contents.setZoomFactor(1.5);
+
+      let zoomFactor = 0;
+      let loading = false;
+      for (let i = 0; i < iterations; i++) {
+        zoomFactor = contents.getZoomFactor();
+        loading = loading || contents.isLoading() || contents.isDestroyed();
+      }
+      expect(zoomFactor).to.equal(1.5);
+      expect(loading).to.be.false();
+
+      const destroyed = once(contents, 'destroyed');
+      contents.destroy();
+      await destroyed;
+      expect(contents.isDestroyed()).to.be.true();
+      expect(() => contents.getZoomFactor()).to.throw(/Object has been destroyed/);
+    });
+  });
+
   describe('did-change-theme-color event', () => {
     afterEach(closeAllWindows);
     it('is triggered with correct theme color', (done) => {
@@ -2324,6 +2434,49 @@ describe('webContents module', () => {
       }
     });
 
+    it('can gzip the snapshot', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const filePath = path.join(app.getPath('temp'), 'test.heapsnapshot.gz');
+      defer(() => fs.rmSync(filePath, { force: true }));
+
+      await w.webContents.takeHeapSnapshot(filePath, { compression: 'gzip' });
+      const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString());
+      expect(snapshot).to.have.property('snapshot');
+      expect(snapshot.nodes).to.be.an('array').that.is.not.empty();
+    });
+
+    ifit(process.platform !== 'win32')('streams the snapshot to a FIFO', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const fifoPath = path.join(os.tmpdir(), `heapsnapshot-${process.pid}.fifo`);
+      cp.execFileSync('mkfifo', [fifoPath]);
+      defer(() => fs.rmSync(fifoPath, { force: true }));
+
+      // The main thread must not block until the FIFO has a reader.
+      const snapshotTaken = w.webContents.takeHeapSnapshot(fifoPath, { pipe: true });
+      await setTimeout(100);
+      expect(await w.webContents.executeJavaScript('1 + 1')).to.equal(2);
+
+      const chunks: Buffer[] = [];
+      const reader = fs.createReadStream(fifoPath);
+      reader.on('data', (chunk: Buffer) => chunks.push(chunk));
+      await Promise.all([snapshotTaken, once(reader, 'end')]);
+      const snapshot = JSON.parse(Buffer.concat(chunks).toString());
+      expect(snapshot).to.have.property('snapshot');
+    });
+
+    it('rejects an unsupported compression', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const filePath = path.join(app.getPath('temp'), 'test.heapsnapshot');
+      const promise = w.webContents.takeHeapSnapshot(filePath, { compression: 'lz4' as any });
+      await expect(promise).to.be.eventually.rejectedWith(Error, 'Unsupported compression lz4');
+    });
+
     it('fails with invalid file path', async () => {
       const w = new BrowserWindow({
         show: false,
@@ -2355,6 +2508,38 @@ describe('webContents module', () => {
     });
   });
 
+  describe('startHeapSampling() / stopHeapSampling()', () => {
+    afterEach(closeAllWindows);
+
+    it('saves the sampled allocations as a heap profile', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const filePath = path.join(app.getPath('temp'), 'test.heapprofile');
+      defer(() => fs.rmSync(filePath, { force: true }));
+
+      await w.webContents.startHeapSampling({ samplingInterval: 1024 });
+      await w.webContents.executeJavaScript(`
+        window.retained = [];
+        for (let i = 0; i < 10000; i++) window.retained.push({ i, s: 'x'.repeat(100) + i });
+      `);
+      await w.webContents.stopHeapSampling(filePath);
+
+      const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'));
+      expect(profile.head.callFrame).to.have.property('functionName');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('fails when sampling was not started', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const filePath = path.join(app.getPath('temp'), 'test.heapprofile');
+      defer(() => fs.rmSync(filePath, { force: true }));
+      await expect(w.webContents.stopHeapSampling(filePath)).to.be.eventually.rejectedWith(Error, /was it started/);
+    });
+  });
+
   describe('setBackgroundThrottling()', () => {
     afterEach(closeAllWindows);
     it('does not crash when allowing', () => {
@@ -2477,7 +2662,8 @@ describe('webContents module', () => {
         footerTemplate: [4, 5, 6],
         preferCSSPageSize: 'no',
         generateTaggedPDF: 'wtf',
-        generateDocumentOutline: [7, 8, 9]
+        generateDocumentOutline: [7, 8, 9],
+        filePath: 10
       };
 
       await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
@@ -2538,6 +2724,77 @@ describe('webContents module', () => {
       expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
     });
 
+    it('can write a PDF directly to a file', async () => {
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+      const tmpDir = await fs.promises.mkdtemp(path.resolve(os.tmpdir(), 'e-spec-printtopdf-'));
+      defer(() => fs.promises.rm(tmpDir, { force: true, recursive: true }));
+      const filePath = path.join(tmpDir, 'out.pdf');
+      const data = await w.webContents.printToPDF({ filePath });
+      expect(data).to.be.an.instanceof(Buffer).that.is.empty();
+
+      const written = await fs.promises.readFile(filePath);
+      expect(written.subarray(0, 5).toString()).to.equal('%PDF-');
+    });
+
+    it('rejects when the file cannot be written', async () => {
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+      const filePath = path.join(os.tmpdir(), 'e-spec-does-not-exist', 'nested', 'out.pdf');
+      await expect(w.webContents.printToPDF({ filePath })).to.eventually.be.rejectedWith(/Failed to write PDF/);
+    });
+
+    it('can print a batch of documents', async () => {
+      const results = await webContents.printToPDFBatch([
+        { html: '<h1>One</h1>' },
+        { url: 'data:text/html,<h1>Two</h1>', options: { pageSize: 'A4' } },
+        {}
+      ], { concurrency: 2 });
+      expect(results).to.have.lengthOf(3);
+      for (const result of results.slice(0, 2)) {
+        expect(result.error).to.be.undefined();
+        expect(result.data).to.be.an.instanceof(Buffer).that.is.not.empty();
+        expect(result.loadTime).to.be.a('number');
+        expect(result.printTime).to.be.a('number');
+      }
+      expect(results[2].error).to.match(/url or an html/);
+    });
+
+    it('prints large html documents in a batch', async () => {
+      const html = `<p>${'x'.repeat(3 * 1024 * 1024)}</p>`;
+      const [result] = await webContents.printToPDFBatch([{ html }]);
+      expect(result.error).to.be.undefined();
+      expect(result.data).to.be.an.instanceof(Buffer).that.is.not.empty();
+    });
+
+    it('prints html documents on an opaque origin', async () => {
+      const [result] = await webContents.printToPDFBatch([{ html: '<script>document.title = origin + "-batch-origin"</script>' }]);
+      expect(result.error).to.be.undefined();
+      const titles = webContents.getAllWebContents().map(contents => contents.getTitle());
+      expect(titles).to.include('null-batch-origin');
+    });
+
+    it('fails batch jobs that take longer than the timeout', async () => {
+      const results = await webContents.printToPDFBatch([
+        { html: '<script>while (true) {}</script>' },
+        { html: '<h1>After</h1>' }
+      ], { concurrency: 1, timeout: 2000 });
+      expect(results[0].error).to.match(/Timed out after 2000ms/);
+      expect(results[1].error).to.be.undefined();
+      expect(results[1].data).to.be.an.instanceof(Buffer).that.is.not.empty();
+    });
+
+    it('reuses the WebContents of a previous batch', async () => {
+      await webContents.printToPDFBatch([{ html: '<h1>One</h1>' }]);
+      const before = webContents.getAllWebContents().length;
+      await webContents.printToPDFBatch([{ html: '<h1>Two</h1>' }]);
+      expect(webContents.getAllWebContents().length).to.equal(before);
+    });
+
+    it('rejects a non-positive batch concurrency', async () => {
+      await expect(webContents.printToPDFBatch([], { concurrency: 0 })).to.eventually.be.rejectedWith(/concurrency/);
+    });
+
     type PageSizeString = Exclude<Required<Electron.PrintToPDFOptions>['pageSize'], Electron.Size>;
 
     it('with custom page sizes', async () => {
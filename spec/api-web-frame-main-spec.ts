@@ -269,6 +269,69 @@ describe('webFrameMain module', () => {
     });
   });
 
+  describe('WebFrame.executeJavaScriptInSubtree', () => {
+    it('runs code in every frame of the subtree', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const webFrame = w.webContents.mainFrame;
+
+      const results = await webFrame.executeJavaScriptInSubtree('location.href');
+      expect(results.map(r => r.status)).to.deep.equal(['fulfilled', 'fulfilled', 'fulfilled']);
+      expect(results.map(r => r.value)).to.deep.equal([
+        fileUrl('frame-with-frame-container.html'),
+        fileUrl('frame-with-frame.html'),
+        fileUrl('frame.html')
+      ]);
+      expect(results.map(r => r.routingId)).to.deep.equal(webFrame.framesInSubtree.map(f => f.routingId));
+    });
+
+    it('settles frames that throw without failing the others', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const webFrame = w.webContents.mainFrame;
+
+      const results = await webFrame.executeJavaScriptInSubtree('if (window !== top) throw new Error("nested"); 42');
+      expect(results[0]).to.include({ status: 'fulfilled', value: 42 });
+      expect(results.slice(1).map(r => r.status)).to.deep.equal(['rejected', 'rejected']);
+      expect(results[1].reason).to.be.a('string').that.includes('nested');
+    });
+
+    it('fulfills frames whose code evaluates to undefined', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const webFrame = w.webContents.mainFrame;
+
+      const results = await webFrame.executeJavaScriptInSubtree('window.TEMP');
+      expect(results.map(r => r.status)).to.deep.equal(['fulfilled', 'fulfilled', 'fulfilled']);
+      expect(results.map(r => r.value)).to.deep.equal([null, null, null]);
+    });
+
+    it('awaits promises and reports their rejection', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const webFrame = w.webContents.mainFrame;
+
+      const results = await webFrame.executeJavaScriptInSubtree('window === top ? Promise.resolve(1) : Promise.reject(new Error("nested"))');
+      expect(results[0]).to.include({ status: 'fulfilled', value: 1 });
+      expect(results.slice(1).map(r => r.status)).to.deep.equal(['rejected', 'rejected']);
+      expect(results[1].reason).to.include('nested');
+    });
+
+    it('runs code in frames of other renderer processes', async () => {
+      const server = await createServer();
+      defer(() => server.server.close());
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL(`${server.url}?frameSrc=${encodeURIComponent(server.crossOriginUrl)}`);
+      const webFrame = w.webContents.mainFrame;
+      expect(webFrame.frames[0].processId).to.not.equal(webFrame.processId);
+
+      const results = await webFrame.executeJavaScriptInSubtree('location.origin');
+      expect(results.map(r => r.status)).to.deep.equal(['fulfilled', 'fulfilled']);
+      expect(results.map(r => r.processId)).to.deep.equal([webFrame.processId, webFrame.frames[0].processId]);
+      expect(results.map(r => r.value)).to.deep.equal([new URL(server.url).origin, new URL(server.crossOriginUrl).origin]);
+    });
+  });
+
   describe('WebFrame.reload', () => {
     it('reloads a frame', async () => {
       const w = new BrowserWindow({ show: false });
@@ -300,6 +363,55 @@ describe('webFrameMain module', () => {
     });
   });
 
+  describe('webFrameMain.broadcast', () => {
+    const createWindow = async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          preload: path.join(subframesPath, 'preload.js'),
+          nodeIntegrationInSubFrames: true
+        }
+      });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame.html'));
+      return w;
+    };
+
+    it('sends the message to every frame', async () => {
+      const windows = [await createWindow(), await createWindow()];
+      const frames = windows.map(w => w.webContents.mainFrame);
+      const pongs = emittedNTimes(ipcMain, 'preload-pong', frames.length);
+      expect(webFrameMain.broadcast(frames, 'preload-ping')).to.equal(frames.length);
+      const routingIds = (await pongs).map(([, routingId]) => routingId);
+      expect(routingIds).to.have.members(frames.map(frame => frame.routingId));
+    });
+
+    it('skips destroyed frames', async () => {
+      const w = await createWindow();
+      const frame = w.webContents.mainFrame;
+      const other = await createWindow();
+      const otherFrame = other.webContents.mainFrame;
+      other.destroy();
+      await waitUntil(() => otherFrame.isDestroyed());
+      expect(webFrameMain.broadcast([frame, otherFrame], 'preload-ping')).to.equal(1);
+    });
+
+    it('can send to every frame of a WebContents', async () => {
+      const w = await createWindow();
+      const frames = w.webContents.mainFrame.framesInSubtree;
+      const pongs = emittedNTimes(ipcMain, 'preload-pong', frames.length);
+      expect(w.webContents.sendToAllFrames('preload-ping')).to.equal(frames.length);
+      const routingIds = (await pongs).map(([, routingId]) => routingId);
+      expect(routingIds).to.have.members(frames.map(frame => frame.routingId));
+    });
+
+    it('throws when the arguments cannot be serialized', async () => {
+      const w = await createWindow();
+      expect(() => {
+        webFrameMain.broadcast([w.webContents.mainFrame], 'preload-ping', () => {});
+      }).to.throw(/Failed to serialize arguments/);
+    });
+  });
+
   describe('RenderFrame lifespan', () => {
     let server: Awaited<ReturnType<typeof createServer>>;
     let w: BrowserWindow;
@@ -58,11 +58,13 @@ describe('webFrame module', () => {
 
     const spellCheckerFeedback =
       new Promise<[string[], boolean]>(resolve => {
+        const allWords = new Set<string>();
         ipcMain.on('spec-spell-check', (e, words, callbackDefined) => {
-          if (words.length === 5) {
-            // The API calls the provider after every completed word.
-            // The promise is resolved only after this event is received with all words.
-            resolve([words, callbackDefined]);
+          // The API calls the provider after every completed word, but only
+          // with the words it has not checked before.
+          for (const word of words) allWords.add(word);
+          if (allWords.size === 5) {
+            resolve([[...allWords], callbackDefined]);
           }
         });
       });
@@ -75,6 +77,39 @@ describe('webFrame module', () => {
     expect(callbackDefined).to.be.true();
   });
 
+  it('does not send already checked words to the spellcheck provider', async () => {
+    const w = new BrowserWindow({
+      show: false,
+      webPreferences: {
+        nodeIntegration: true,
+        contextIsolation: false
+      }
+    });
+    defer(() => w.close());
+    await w.loadFile(path.join(fixtures, 'pages', 'webframe-spell-check.html'));
+    w.focus();
+    await w.webContents.executeJavaScript('document.querySelector("input").focus()', true);
+
+    const requestedWords: string[] = [];
+    const onSpellCheck = (e: Electron.IpcMainEvent, words: string[]) => { requestedWords.push(...words); };
+    ipcMain.on('spec-spell-check', onSpellCheck);
+    defer(() => ipcMain.off('spec-spell-check', onSpellCheck));
+
+    const secondWordChecked = new Promise<void>(resolve => {
+      ipcMain.on('spec-spell-check', function listener (e, words) {
+        if (words.includes('world')) {
+          ipcMain.off('spec-spell-check', listener);
+          resolve();
+        }
+      });
+    });
+    for (const keyCode of 'hello hello world ') {
+      w.webContents.sendInputEvent({ type: 'char', keyCode });
+    }
+    await secondWordChecked;
+    expect(requestedWords.filter(word => word === 'hello')).to.have.lengthOf(1);
+  });
+
   describe('api', () => {
     let w: WebContents;
     let win: BrowserWindow;
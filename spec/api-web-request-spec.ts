@@ -199,7 +199,9 @@ describe('webRequest module', () => {
       ses.webRequest.onBeforeRequest((details, callback) => {
         expect(details.url).to.equal(defaultURL);
         expect(details.method).to.equal('POST');
+        expect(Object.keys(details)).to.include('uploadData');
         expect(details.uploadData).to.have.lengthOf(1);
+        expect(details.uploadData).to.equal(details.uploadData);
         const data = qs.parse(details.uploadData[0].bytes.toString());
         expect(data).to.deep.equal(postData);
         callback({ cancel: true });
@@ -636,6 +638,153 @@ describe('webRequest module', () => {
     });
   });
 
+  describe('webRequest.addListener', () => {
+    const listeners: [string, Function][] = [];
+    const addListener = (eventName: string, ...args: any[]) => {
+      listeners.push([eventName, args.find(arg => typeof arg === 'function')]);
+      (ses.webRequest.addListener as Function)(eventName, ...args);
+    };
+    afterEach(() => {
+      for (const [eventName, listener] of listeners.splice(0)) {
+        ses.webRequest.removeListener(eventName, listener);
+      }
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('calls every listener whose filter matches', async () => {
+      const called: string[] = [];
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        called.push('on');
+        callback({});
+      });
+      addListener('onBeforeRequest', (details: any, callback: Function) => {
+        called.push('all');
+        callback({});
+      });
+      addListener('onBeforeRequest', { urls: ['http://nonexistent/*'] }, (details: any, callback: Function) => {
+        called.push('unmatched');
+        callback({});
+      });
+      await ajax(defaultURL);
+      expect(called).to.have.members(['on', 'all']);
+    });
+
+    it('calls listeners in priority order', async () => {
+      const called: number[] = [];
+      for (const priority of [1, 3, 2]) {
+        addListener('onResponseStarted', () => { called.push(priority); }, { priority });
+      }
+      await ajax(defaultURL);
+      expect(called).to.deep.equal([3, 2, 1]);
+    });
+
+    it('cancels the request when any listener cancels it', async () => {
+      addListener('onBeforeRequest', (details: any, callback: Function) => callback({}));
+      addListener('onBeforeRequest', (details: any, callback: Function) => callback({ cancel: true }));
+      await expect(ajax(defaultURL)).to.eventually.be.rejected();
+    });
+
+    it('uses the redirect of the highest-priority listener', async () => {
+      const redirect = (path: string) => (details: any, callback: Function) => {
+        callback(details.url === defaultURL ? { redirectURL: `${defaultURL}${path}` } : {});
+      };
+      addListener('onBeforeRequest', redirect('low'), { priority: 1 });
+      addListener('onBeforeRequest', redirect('high'), { priority: 2 });
+      addListener('onBeforeRequest', (details: any, callback: Function) => callback({}), { priority: 3 });
+      const { data } = await ajax(defaultURL);
+      expect(data).to.equal('/high');
+    });
+
+    it('merges the request headers changed by every listener', async () => {
+      const setHeader = (name: string, value: string) => (details: any, callback: Function) => {
+        callback({ requestHeaders: { ...details.requestHeaders, [name]: value } });
+      };
+      addListener('onBeforeSendHeaders', setHeader('X-Low', 'low'), { priority: 1 });
+      addListener('onBeforeSendHeaders', setHeader('X-Shared', 'low'), { priority: 1 });
+      addListener('onBeforeSendHeaders', setHeader('X-Shared', 'high'), { priority: 2 });
+      addListener('onBeforeSendHeaders', (details: any, callback: Function) => callback({}), { priority: 3 });
+      let headers: Record<string, string> = {};
+      addListener('onSendHeaders', (details: any) => { headers = details.requestHeaders; });
+      await ajax(defaultURL);
+      expect(headers).to.include({ 'X-Low': 'low', 'X-Shared': 'high' });
+    });
+
+    it('merges the response headers changed by every listener', async () => {
+      const setHeader = (name: string, value: string) => (details: any, callback: Function) => {
+        callback({ responseHeaders: { ...details.responseHeaders, [name]: [value] } });
+      };
+      addListener('onHeadersReceived', setHeader('X-Low', 'low'), { priority: 1 });
+      addListener('onHeadersReceived', setHeader('X-High', 'high'), { priority: 2 });
+      addListener('onHeadersReceived', (details: any, callback: Function) => {
+        const responseHeaders = { ...details.responseHeaders };
+        delete responseHeaders.Custom;
+        callback({ responseHeaders });
+      });
+      const { headers } = await ajax(defaultURL);
+      expect(headers).to.include({ 'x-low': 'low', 'x-high': 'high' });
+      expect(headers).to.not.have.property('custom');
+    });
+
+    it('stops calling a removed listener', async () => {
+      let called = false;
+      const listener = () => { called = true; };
+      ses.webRequest.addListener('onCompleted', listener);
+      ses.webRequest.removeListener('onCompleted', listener);
+      await ajax(defaultURL);
+      expect(called).to.be.false();
+    });
+
+    it('throws for an unknown event name', () => {
+      expect(() => {
+        ses.webRequest.addListener('onNothing', () => {});
+      }).to.throw(/Invalid event name onNothing/);
+    });
+  });
+
+  describe('webRequest.setObserver', () => {
+    afterEach(() => {
+      ses.webRequest.setObserver(null);
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('receives batches of observations', async () => {
+      const observed = new Promise<Electron.WebRequestObservation[]>(resolve => {
+        const observations: Electron.WebRequestObservation[] = [];
+        ses.webRequest.setObserver({ urls: [`${defaultURL}observed`] }, (batch) => {
+          observations.push(...batch);
+          if (observations.some(o => o.event === 'onCompleted')) resolve(observations);
+        }, { interval: 10 });
+      });
+      await ajax(defaultURL);
+      await ajax(`${defaultURL}observed`);
+      const observations = await observed;
+      expect(observations.every(o => o.url === `${defaultURL}observed`)).to.be.true();
+      const events = observations.map(o => o.event);
+      expect(events).to.include.members(['onBeforeRequest', 'onResponseStarted', 'onCompleted']);
+      const completed = observations.find(o => o.event === 'onCompleted')!;
+      expect(completed.statusCode).to.equal(200);
+      expect(completed.method).to.equal('GET');
+    });
+
+    it('observes requests cancelled by other listeners', async () => {
+      ses.webRequest.onBeforeRequest((details, callback) => callback({ cancel: true }));
+      const observed = new Promise<Electron.WebRequestObservation>(resolve => {
+        ses.webRequest.setObserver((batch) => {
+          const error = batch.find(o => o.event === 'onErrorOccurred');
+          if (error) resolve(error);
+        }, { interval: 0 });
+      });
+      await expect(ajax(defaultURL)).to.eventually.be.rejected();
+      expect((await observed).error).to.equal('net::ERR_BLOCKED_BY_CLIENT');
+    });
+
+    it('rejects a negative interval', () => {
+      expect(() => {
+        ses.webRequest.setObserver(() => {}, { interval: -1 });
+      }).to.throw(/'interval' must not be negative/);
+    });
+  });
+
   describe('WebSocket connections', () => {
     it('can be proxyed', async () => {
       // Setup server.
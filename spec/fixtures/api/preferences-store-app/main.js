@@ -0,0 +1,26 @@
+const { app, session } = require('electron');
+
+app.setPath('userData', process.env.USER_DATA);
+
+app.whenReady().then(() => {
+  const logSession = session.fromPartition('persist:preferences-store', {
+    preferencesStore: process.env.STORE
+  });
+  const inMemorySession = session.fromPartition('preferences-store');
+
+  if (process.env.PHASE === 'write') {
+    session.defaultSession.setSpellCheckerEnabled(false);
+    logSession.setSpellCheckerEnabled(false);
+    // Must not end up in the default session's Preferences file.
+    inMemorySession.setDownloadPath(process.env.IN_MEMORY_DOWNLOAD_PATH);
+  } else {
+    process.stdout.write(JSON.stringify({
+      defaultSession: session.defaultSession.isSpellCheckerEnabled(),
+      logSession: logSession.isSpellCheckerEnabled(),
+      inMemorySession: inMemorySession.isSpellCheckerEnabled()
+    }));
+  }
+
+  process.stdout.end();
+  app.quit();
+});
@@ -0,0 +1,11 @@
+process.parentPort.once('message', async ({ data: filePath }) => {
+  process.startCpuProfiling({ samplingInterval: 1 });
+  const end = Date.now() + 200;
+  while (Date.now() < end) {
+    await new Promise(resolve => setTimeout(resolve, 10));
+    JSON.stringify(Array.from({ length: 10000 }, (_, i) => i));
+  }
+  const success = process.writeCpuProfile(filePath);
+  process.stopCpuProfiling();
+  process.parentPort.postMessage(success);
+});
@@ -136,6 +136,7 @@ declare namespace NodeJS {
     fromId(processId: number, routingId: number): Electron.WebFrameMain;
     _fromIdIfExists(processId: number, routingId: number): Electron.WebFrameMain | null;
     _fromFtnIdIfExists(frameTreeNodeId: number): Electron.WebFrameMain | null;
+    _broadcast(internal: boolean, channel: string, args: any[], frames: Electron.WebFrameMain[]): number;
   }
 
   interface InternalWebPreferences {
@@ -177,6 +178,7 @@ declare namespace NodeJS {
     mode?: string;
     destination?: string;
     bypassCustomProtocolHandlers?: boolean;
+    chunkSize?: number;
   };
   type ResponseHead = {
     statusCode: number;
@@ -198,7 +200,7 @@ declare namespace NodeJS {
 
   interface URLLoader extends EventEmitter {
     cancel(): void;
-    on(eventName: 'data', listener: (event: any, data: ArrayBuffer, resume: () => void) => void): this;
+    on(eventName: 'data', listener: (event: any, data: ArrayBuffer, resume: () => void, length: number) => void): this;
     on(eventName: 'response-started', listener: (event: any, finalUrl: string, responseHead: ResponseHead) => void): this;
     on(eventName: 'complete', listener: (event: any) => void): this;
     on(eventName: 'error', listener: (event: any, netErrorString: string) => void): this;
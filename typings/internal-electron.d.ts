@@ -17,6 +17,7 @@ declare namespace Electron {
     setVersion(version: string): void;
     setDesktopName(name: string): void;
     setAppPath(path: string | null): void;
+    _markStartup(name: string): void;
     _clientCertRequestPasswordHandler: ((params: ClientCertRequestParams) => Promise<string>) | null;
     on(event: '-client-certificate-request-password', listener: (event: Event<ClientCertRequestParams>, callback: (password: string) => void) => Promise<void>): this;
   }
@@ -230,6 +231,7 @@ declare namespace Electron {
   interface Protocol {
     registerProtocol(scheme: string, handler: any): boolean;
     interceptProtocol(scheme: string, handler: any): boolean;
+    _getResponseCacheMaxSize(scheme: string): number | null;
   }
 
   interface WebContents {